@@ -0,0 +1,13 @@
+/* Simulation hôte (csr_sim) : types de base du HAL Nios II */
+#ifndef __ALT_TYPES_H__
+#define __ALT_TYPES_H__
+
+#include <stdint.h>
+
+typedef uint8_t  alt_u8;
+typedef uint16_t alt_u16;
+typedef uint32_t alt_u32;
+typedef uint64_t alt_u64;
+typedef int32_t  alt_32;
+
+#endif /* __ALT_TYPES_H__ */
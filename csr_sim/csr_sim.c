@@ -0,0 +1,307 @@
+/******************************************************************************
+ *  csr_sim : simulateur hôte des IP oneAPI à interface CSR — voir csr_sim.h
+ *
+ *  Un thread par IP : un start (bit 0 de START) incrémente les lancements en
+ *  attente et passe BUSY à 1 ; le thread exécute le modèle, compte la fin
+ *  (FINISH_CNT), lève DONE et le bit 0 de IRQ_STATUS, puis appelle l'ISR si
+ *  l'IRQ est autorisée. L'ISR s'exécute sous le verrou global des IRQ, que
+ *  alt_irq_disable_all() prend aussi côté programme principal.
+ ******************************************************************************/
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "csr_sim.h"
+#include "system.h"
+#include "sys/alt_irq.h"
+#include "transpose_drv.h"  /* offsets de contrôle, transpose_desc_t */
+
+uint8_t csr_sim_onchip[CSR_SIM_ONCHIP_BYTES] __attribute__((aligned(64)));
+uint8_t csr_sim_emif[CSR_SIM_EMIF_BYTES] __attribute__((aligned(64)));
+
+/* ---------- Une IP simulée ---------------------------------------------- */
+typedef struct {
+    const char       *name;
+    uint32_t          base;
+    uint32_t          irq;
+    csr_sim_kernel_t  kernel;
+    void             *user;
+
+    uint32_t          regs[CSR_SIM_SPAN / 4]; /* arguments et registres bruts */
+    uint32_t          done;
+    uint32_t          busy;
+    uint32_t          pending;                /* starts non encore exécutés   */
+    uint32_t          irq_enable;
+    uint32_t          irq_status;
+    uint32_t          finish_cnt;
+
+    alt_isr_func      isr;
+    void             *isr_context;
+
+    csr_sim_stats_t   stats;
+    pthread_mutex_t   m;
+    pthread_cond_t    c;
+    pthread_t         thread;
+} ip_t;
+
+static ip_t     ips[CSR_SIM_MAX_IP];
+static int      nb_ips;
+static uint32_t latency_us;
+static pthread_mutex_t irq_lock;
+
+static ip_t *find(uint32_t addr)
+{
+    for (int i = 0; i < nb_ips; ++i)
+        if (addr - ips[i].base < CSR_SIM_SPAN)
+            return &ips[i];
+    fprintf(stderr, "csr_sim : accès à 0x%08x hors de toute IP\n", (unsigned)addr);
+    abort();
+}
+
+/* ---------- Thread d'exécution du kernel --------------------------------- */
+static void *run(void *arg)
+{
+    ip_t *ip = (ip_t *)arg;
+    for (;;) {
+        pthread_mutex_lock(&ip->m);
+        while (ip->pending == 0)
+            pthread_cond_wait(&ip->c, &ip->m);
+        pthread_mutex_unlock(&ip->m);
+
+        if (latency_us)
+            usleep(latency_us);
+        ip->kernel(ip->base, ip->user);
+
+        pthread_mutex_lock(&ip->m);
+        ip->pending--;
+        ip->busy = ip->pending != 0;
+        ip->done = 1;
+        ip->finish_cnt++;
+        ip->irq_status |= TRANSPOSE_IRQ_MASK;
+        const int deliver = (ip->irq_enable & TRANSPOSE_IRQ_MASK) && ip->isr != NULL;
+        ip->stats.irqs += deliver;
+        pthread_mutex_unlock(&ip->m);
+
+        if (deliver) {
+            pthread_mutex_lock(&irq_lock);
+            ip->isr(ip->isr_context);
+            pthread_mutex_unlock(&irq_lock);
+        }
+    }
+    return NULL;
+}
+
+/* ---------- Bus ----------------------------------------------------------- */
+void csr_sim_wr(uint32_t addr, uint32_t v, int bytes)
+{
+    ip_t *ip = find(addr);
+    const uint32_t off = addr - ip->base;
+
+    pthread_mutex_lock(&ip->m);
+    ip->stats.writes++;
+    switch (off) {
+    case TRANSPOSE_START_OFF:
+        if (v & 1) {
+            ip->pending++;
+            ip->busy = 1;
+            ip->done = 0;
+            ip->stats.starts++;
+            pthread_cond_signal(&ip->c);
+        }
+        break;
+    case TRANSPOSE_IRQ_ENABLE_OFF:
+        ip->irq_enable = v;
+        break;
+    case TRANSPOSE_IRQ_STATUS_OFF:
+        ip->irq_status &= ~v;                 /* écrire 1 efface */
+        break;
+    default: {
+        /* Arguments : fusion des octets écrits dans le mot de 32 bits */
+        const uint32_t shift = (off & 3) * 8;
+        const uint32_t mask = (bytes == 4 ? 0xFFFFFFFFu : ((1u << (bytes * 8)) - 1)) << shift;
+        uint32_t *r = &ip->regs[off / 4];
+        *r = (*r & ~mask) | ((v << shift) & mask);
+        break;
+    }
+    }
+    pthread_mutex_unlock(&ip->m);
+}
+
+uint32_t csr_sim_rd(uint32_t addr, int bytes)
+{
+    ip_t *ip = find(addr);
+    const uint32_t off = addr - ip->base;
+    uint32_t v;
+
+    pthread_mutex_lock(&ip->m);
+    ip->stats.reads++;
+    switch (off) {
+    case TRANSPOSE_STATUS_OFF:
+        v = (ip->done ? TRANSPOSE_DONE_MASK : 0) | (ip->busy ? TRANSPOSE_BUSY_MASK : 0);
+        break;
+    case TRANSPOSE_IRQ_ENABLE_OFF:
+        v = ip->irq_enable;
+        break;
+    case TRANSPOSE_IRQ_STATUS_OFF:
+        v = ip->irq_status;
+        break;
+    case TRANSPOSE_FINISH_CNT_OFF:
+        v = ip->finish_cnt;                   /* remis à zéro par la lecture */
+        ip->finish_cnt = 0;
+        break;
+    default:
+        v = ip->regs[off / 4] >> ((off & 3) * 8);
+        if (bytes < 4)
+            v &= (1u << (bytes * 8)) - 1;
+        break;
+    }
+    pthread_mutex_unlock(&ip->m);
+    return v;
+}
+
+uint32_t csr_sim_arg32(uint32_t base, uint32_t off)
+{
+    ip_t *ip = find(base);
+    pthread_mutex_lock(&ip->m);
+    const uint32_t v = ip->regs[off / 4];
+    pthread_mutex_unlock(&ip->m);
+    return v;
+}
+
+uint64_t csr_sim_arg64(uint32_t base, uint32_t off)
+{
+    return csr_sim_arg32(base, off) | ((uint64_t)csr_sim_arg32(base, off + 4) << 32);
+}
+
+int csr_sim_stats(uint32_t base, csr_sim_stats_t *stats)
+{
+    ip_t *ip = find(base);
+    pthread_mutex_lock(&ip->m);
+    *stats = ip->stats;
+    pthread_mutex_unlock(&ip->m);
+    return 0;
+}
+
+/* ---------- HAL : IRQ ----------------------------------------------------- */
+int alt_ic_isr_register(alt_u32 ic_id, alt_u32 irq, alt_isr_func isr,
+                        void *isr_context, void *flags)
+{
+    (void)ic_id;
+    (void)flags;
+    for (int i = 0; i < nb_ips; ++i) {
+        if (ips[i].irq == irq) {
+            pthread_mutex_lock(&ips[i].m);
+            ips[i].isr = isr;
+            ips[i].isr_context = isr_context;
+            pthread_mutex_unlock(&ips[i].m);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+alt_irq_context alt_irq_disable_all(void)
+{
+    pthread_mutex_lock(&irq_lock);
+    return 0;
+}
+
+void alt_irq_enable_all(alt_irq_context context)
+{
+    (void)context;
+    pthread_mutex_unlock(&irq_lock);
+}
+
+/* ---------- Modèles des IP transpose ------------------------------------- */
+static void transpose_frame(uint8_t *out, const uint8_t *in,
+                            uint32_t rows, uint32_t cols, size_t e)
+{
+    for (uint32_t r = 0; r < rows; ++r)
+        for (uint32_t c = 0; c < cols; ++c)
+            memcpy(out + ((size_t)c * rows + r) * e, in + ((size_t)r * cols + c) * e, e);
+}
+
+void csr_sim_transpose(uint32_t base, void *user)
+{
+    transpose_frame((uint8_t *)(uintptr_t)csr_sim_arg64(base, TRANSPOSE_ARG_OUT_OFF),
+                    (const uint8_t *)(uintptr_t)csr_sim_arg64(base, TRANSPOSE_ARG_IN_OFF),
+                    csr_sim_arg32(base, TRANSPOSE_ARG_ROWS_OFF),
+                    csr_sim_arg32(base, TRANSPOSE_ARG_COLS_OFF),
+                    user ? (size_t)(uintptr_t)user : 4);
+}
+
+void csr_sim_transpose_ring(uint32_t base, void *user)
+{
+    const uintptr_t in   = (uintptr_t)csr_sim_arg64(base, TRANSPOSE_RING_ARG_IN_OFF);
+    const uintptr_t out  = (uintptr_t)csr_sim_arg64(base, TRANSPOSE_RING_ARG_OUT_OFF);
+    transpose_desc_t *ring =
+        (transpose_desc_t *)(uintptr_t)csr_sim_arg64(base, TRANSPOSE_RING_ARG_RING_OFF);
+    const uint32_t size  = csr_sim_arg32(base, TRANSPOSE_RING_ARG_RINGSIZE_OFF);
+    const uint32_t count = csr_sim_arg32(base, TRANSPOSE_RING_ARG_COUNT_OFF);
+    uint32_t idx         = csr_sim_arg32(base, TRANSPOSE_RING_ARG_FIRST_OFF);
+
+    for (uint32_t d = 0; d < count; ++d) {
+        transpose_desc_t *desc = &ring[idx];
+        if (desc->rows != 0 && desc->cols != 0)
+            transpose_frame((uint8_t *)(out + (uintptr_t)desc->out),
+                            (const uint8_t *)(in + (uintptr_t)desc->in),
+                            desc->rows, desc->cols, user ? (size_t)(uintptr_t)user : 4);
+        __atomic_store_n(&desc->status, desc->seq, __ATOMIC_RELEASE);
+        if (++idx == size)
+            idx = 0;
+    }
+}
+
+/* ---------- Déclaration des IP de system.h ------------------------------- */
+void csr_sim_attach(const char *name, uint32_t base, uint32_t irq,
+                    csr_sim_kernel_t kernel, void *user)
+{
+    if (nb_ips == CSR_SIM_MAX_IP) {
+        fprintf(stderr, "csr_sim : plus de %d IP\n", CSR_SIM_MAX_IP);
+        abort();
+    }
+    ip_t *ip = &ips[nb_ips++];
+    memset(ip, 0, sizeof(*ip));
+    ip->name   = name;
+    ip->base   = base;
+    ip->irq    = irq;
+    ip->kernel = kernel;
+    ip->user   = user;
+    pthread_mutex_init(&ip->m, NULL);
+    pthread_cond_init(&ip->c, NULL);
+    pthread_create(&ip->thread, NULL, run, ip);
+    pthread_detach(ip->thread);
+}
+
+static void bilan(void)
+{
+    for (int i = 0; i < nb_ips; ++i) {
+        csr_sim_stats_t s;
+        csr_sim_stats(ips[i].base, &s);
+        fprintf(stderr, "csr_sim %-10s : %u écritures, %u lectures, %u starts, %u IRQ\n",
+                ips[i].name, (unsigned)s.writes, (unsigned)s.reads,
+                (unsigned)s.starts, (unsigned)s.irqs);
+    }
+}
+
+__attribute__((constructor)) static void csr_sim_init(void)
+{
+    pthread_mutexattr_t a;
+    pthread_mutexattr_init(&a);
+    pthread_mutexattr_settype(&a, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&irq_lock, &a);
+
+    const char *lat = getenv("CSR_SIM_LATENCY_US");
+    latency_us = lat ? (uint32_t)strtoul(lat, NULL, 0) : 0;
+    if (getenv("CSR_SIM_VERBOSE"))
+        atexit(bilan);
+
+    csr_sim_attach("transpose", TRANSPOSE_REPORT_DI_1_BASE, TRANSPOSE_REPORT_DI_1_IRQ,
+                   csr_sim_transpose, (void *)4);
+    csr_sim_attach("ring", TRANSPOSE_RING_DI_0_BASE, TRANSPOSE_RING_DI_0_IRQ,
+                   csr_sim_transpose_ring, (void *)4);
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+ *  csr_sim : simulateur hôte (Linux) des IP oneAPI à interface CSR
+ *
+ *  Remplace le HAL Nios II (io.h, system.h, sys/alt_irq.h, sys/alt_cache.h de
+ *  ce répertoire) pour compiler le pilote et nios_ddr.c sans carte :
+ *
+ *      cc -std=gnu99 -O2 -pthread -Icsr_sim -I. \
+ *         nios_ddr.c transpose_drv.c nios_buf.c csr_sim/csr_sim.c -o nios_sim
+ *
+ *  Chaque IP simulée a son banc de registres (carte oneAPI : STATUS, START,
+ *  IRQ, compteur de fins, arguments à partir de 0x80) et un thread qui
+ *  exécute le modèle du kernel à chaque start, puis lève DONE et l'IRQ :
+ *  les fins arrivent donc vraiment en asynchrone, comme sur la carte.
+ *
+ *  Variables d'environnement :
+ *      CSR_SIM_LATENCY_US  durée ajoutée à chaque exécution de kernel
+ *      CSR_SIM_VERBOSE     bilan des accès CSR par IP en fin de programme
+ ******************************************************************************/
+
+#ifndef __CSR_SIM_H__
+#define __CSR_SIM_H__
+
+#include <stdint.h>
+
+#define CSR_SIM_SPAN         0x100       /* octets de registres par IP     */
+#define CSR_SIM_MAX_IP       8
+#define CSR_SIM_ONCHIP_BYTES (256 * 1024)
+#define CSR_SIM_EMIF_BYTES   (16 * 1024 * 1024)
+
+extern uint8_t csr_sim_onchip[CSR_SIM_ONCHIP_BYTES];
+extern uint8_t csr_sim_emif[CSR_SIM_EMIF_BYTES];
+
+/* Modèle de kernel : lit ses arguments avec csr_sim_arg*(base, off) */
+typedef void (*csr_sim_kernel_t)(uint32_t base, void *user);
+
+/* Déclare une IP à l'adresse base, reliée à l'IRQ irq */
+void     csr_sim_attach(const char *name, uint32_t base, uint32_t irq,
+                        csr_sim_kernel_t kernel, void *user);
+
+/* Accès bus (io.h) */
+void     csr_sim_wr(uint32_t addr, uint32_t v, int bytes);
+uint32_t csr_sim_rd(uint32_t addr, int bytes);
+
+/* Lecture des arguments par les modèles */
+uint32_t csr_sim_arg32(uint32_t base, uint32_t off);
+uint64_t csr_sim_arg64(uint32_t base, uint32_t off);
+
+/* Compteurs d'accès depuis le démarrage */
+typedef struct {
+    uint32_t writes;
+    uint32_t reads;
+    uint32_t starts;
+    uint32_t irqs;
+} csr_sim_stats_t;
+
+int      csr_sim_stats(uint32_t base, csr_sim_stats_t *stats);
+
+/* Modèles des IP transpose (éléments de user octets, (void *)4 par défaut) */
+void     csr_sim_transpose(uint32_t base, void *user);
+void     csr_sim_transpose_ring(uint32_t base, void *user);
+
+#endif /* __CSR_SIM_H__ */
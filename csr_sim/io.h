@@ -0,0 +1,15 @@
+/* Simulation hôte (csr_sim) : accès CSR du HAL Nios II redirigés vers le
+ * simulateur de registres. Les adresses de base sont celles de system.h. */
+#ifndef __IO_H__
+#define __IO_H__
+
+#include "csr_sim.h"
+
+#define IOWR_32DIRECT(base, off, v) csr_sim_wr((uint32_t)(base) + (off), (uint32_t)(v), 4)
+#define IOWR_16DIRECT(base, off, v) csr_sim_wr((uint32_t)(base) + (off), (uint32_t)(v), 2)
+#define IOWR_8DIRECT(base, off, v)  csr_sim_wr((uint32_t)(base) + (off), (uint32_t)(v), 1)
+#define IORD_32DIRECT(base, off)    csr_sim_rd((uint32_t)(base) + (off), 4)
+#define IORD_16DIRECT(base, off)    csr_sim_rd((uint32_t)(base) + (off), 2)
+#define IORD_8DIRECT(base, off)     csr_sim_rd((uint32_t)(base) + (off), 1)
+
+#endif /* __IO_H__ */
@@ -0,0 +1,15 @@
+/* Simulation hôte (csr_sim) : le cache du Nios n'existe pas, les IP
+ * simulées lisent et écrivent directement la mémoire du processus. */
+#ifndef __ALT_CACHE_H__
+#define __ALT_CACHE_H__
+
+#include "alt_types.h"
+
+static inline void alt_dcache_flush(void *start, alt_u32 len) { (void)start; (void)len; }
+static inline void alt_dcache_flush_all(void) {}
+static inline void alt_dcache_flush_no_writeback(void *start, alt_u32 len) { (void)start; (void)len; }
+static inline void alt_icache_flush(void *start, alt_u32 len) { (void)start; (void)len; }
+static inline void *alt_remap_uncached(void *ptr, alt_u32 len) { (void)len; return ptr; }
+static inline void *alt_remap_cached(void *ptr, alt_u32 len) { (void)len; return ptr; }
+
+#endif /* __ALT_CACHE_H__ */
@@ -0,0 +1,17 @@
+/* Simulation hôte (csr_sim) : IRQ du HAL Nios II.
+ * Les ISR tournent dans le thread de l'IP simulée ; alt_irq_disable_all()
+ * prend le verrou qu'elles prennent, ce qui reproduit le masquage. */
+#ifndef __ALT_IRQ_H__
+#define __ALT_IRQ_H__
+
+#include "alt_types.h"
+
+typedef alt_u32 alt_irq_context;
+typedef void (*alt_isr_func)(void *isr_context);
+
+int alt_ic_isr_register(alt_u32 ic_id, alt_u32 irq, alt_isr_func isr,
+                        void *isr_context, void *flags);
+alt_irq_context alt_irq_disable_all(void);
+void alt_irq_enable_all(alt_irq_context context);
+
+#endif /* __ALT_IRQ_H__ */
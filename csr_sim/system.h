@@ -0,0 +1,23 @@
+/* Simulation hôte (csr_sim) : symboles du BSP utilisés par nios_ddr.c.
+ * Les bases CSR sont des adresses fictives interceptées par io.h ; les RAM
+ * sont des tableaux du processus. */
+#ifndef __SYSTEM_H__
+#define __SYSTEM_H__
+
+#include <stdint.h>
+#include "csr_sim.h"
+
+#define TRANSPOSE_REPORT_DI_1_BASE                        0x1000
+#define TRANSPOSE_REPORT_DI_1_IRQ                         1
+#define TRANSPOSE_REPORT_DI_1_IRQ_INTERRUPT_CONTROLLER_ID 0
+
+#define TRANSPOSE_RING_DI_0_BASE                          0x2000
+#define TRANSPOSE_RING_DI_0_IRQ                           2
+#define TRANSPOSE_RING_DI_0_IRQ_INTERRUPT_CONTROLLER_ID   0
+
+#define INTEL_ONCHIP_MEMORY_1_BASE ((uintptr_t)csr_sim_onchip)
+#define INTEL_ONCHIP_MEMORY_1_SPAN CSR_SIM_ONCHIP_BYTES
+#define EMIF_FM_0_ARCH_BASE        ((uintptr_t)csr_sim_emif)
+#define EMIF_FM_0_ARCH_SPAN        CSR_SIM_EMIF_BYTES
+
+#endif /* __SYSTEM_H__ */
@@ -1,62 +1,124 @@
 #include <oneapi/mkl.hpp>
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <iomanip>
 #include <vector>
 #include <complex>
+#include <chrono>
+#include <cmath>
 #include <sycl/ext/intel/fpga_extensions.hpp>
 #include <sycl/sycl.hpp>
 #include "exception_handler.hpp"
+#include "fft_cpu.hpp"
 
-int main() {
-    // Taille de la FFT
-    const std::int64_t N = 64;
+// FFT oneMKL sur CPU par lots (fft_cpu.hpp) : validation contre une DFT
+// directe, puis débit en transformées par seconde, plan en cache.
+// Usage : ./fft [nbElementsParLot]   (défaut 2^22 échantillons par appel)
 
-    // 1) Création d'une queue SYCL (choisir la plateforme/device par défaut)
-    sycl::queue queue{  sycl::cpu_selector_v };
-    std::cout << "Device utilisé : "
-    << queue.get_device().get_info<sycl::info::device::name>()
-    << " [" 
-    << queue.get_device().get_info<sycl::info::device::vendor>() 
-    << "]\n\n";
+// Écart relatif max entre les premières transformées du lot et une DFT directe
+template <typename Real>
+double ecartDft(const std::vector<std::complex<Real>>& x, const std::complex<Real>* X,
+                int64_t N, int64_t nbVerif) {
+    double err = 0.0, ref = 0.0;
+    for (int64_t b = 0; b < nbVerif; ++b) {
+        for (int64_t k = 0; k < N; ++k) {
+            std::complex<double> s = 0.0;
+            for (int64_t n = 0; n < N; ++n)
+                s += std::complex<double>(x[b * N + n]) *
+                     std::polar(1.0, -2.0 * M_PI * double((k * n) % N) / double(N));
+            err = std::max(err, std::abs(std::complex<double>(X[b * N + k]) - s));
+            ref = std::max(ref, std::abs(s));
+        }
+    }
+    return err / ref;
+}
+
+// Un lot de elements / N FFT de N points, au moins une : premier appel
+// (commit compris) puis meilleur temps sur des appels suivants, plan en cache
+template <typename Real>
+bool mesure(fpga_tools::cpu::FftPlanCache& cache, sycl::queue& queue,
+            int64_t N, int64_t elements, double tol) {
+    const int64_t batch = std::max<int64_t>(1, elements / N);
+    std::vector<std::complex<Real>> x(size_t(batch * N));
+    for (int64_t i = 0; i < batch * N; ++i)
+        x[i] = { Real(std::sin(0.01 * double(i))), Real((i % 7) - 3) / Real(8) };
+
+    std::complex<Real>* data = sycl::malloc_shared<std::complex<Real>>(size_t(batch * N), queue);
+    auto charger = [&] { std::copy(x.begin(), x.end(), data); };
+
+    charger();
+    auto d0 = std::chrono::steady_clock::now();
+    cache.forward(data, N, batch).wait();
+    auto d1 = std::chrono::steady_clock::now();
+    const double sPremier = std::chrono::duration<double>(d1 - d0).count();
+    const double ecart = ecartDft(x, data, N, std::min<int64_t>(batch, 4));
 
-    // 2) Préparation des données (initialisation d'un vecteur de N échantillons complexes)
-    std::vector<std::complex<double>> data(N);
-    for (std::int64_t i = 0; i < N; ++i) {
-        // Exemple : un signal réel simple (seule la partie réelle non nulle)
-        data[i] = std::complex<double>(static_cast<double>(i), 0.0);
+    double sCache = 1e30;
+    for (int k = 0; k < 5; ++k) {
+        charger();
+        d0 = std::chrono::steady_clock::now();
+        cache.forward(data, N, batch).wait();
+        d1 = std::chrono::steady_clock::now();
+        sCache = std::min(sCache, std::chrono::duration<double>(d1 - d0).count());
     }
+    sycl::free(data, queue);
 
-    // Affichage des données d'entrée
-    std::cout << "Données d'entrée (complexes) :\n";
-    for (std::int64_t i = 0; i < N; ++i) {
-        std::cout << "  [" << i << "] = " << data[i] << "\n";
+    const bool ok = ecart <= tol;
+    std::cout << std::setw(6) << N << std::setw(8) << (sizeof(Real) == 4 ? "float" : "double")
+              << std::setw(8) << batch
+              << std::setw(14) << std::fixed << std::setprecision(2) << sPremier * 1e3
+              << std::setw(14) << sCache * 1e3
+              << std::setw(16) << std::setprecision(0) << double(batch) / sCache
+              << std::setw(12) << std::scientific << std::setprecision(1) << ecart
+              << (ok ? "  OK" : "  KO") << std::defaultfloat << '\n';
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    const int64_t elements = argc > 1 ? std::atoll(argv[1]) : int64_t(1) << 22;
+    if (elements < 1) {
+        std::cerr << "Usage : " << argv[0] << " [nbEléments >= 1]\n";
+        return EXIT_FAILURE;
     }
-    std::cout << "\n";
 
-    // 3) Allocation d'un buffer SYCL pour les données
-    {
-        sycl::buffer<std::complex<double>, 1> buf(data.data(), sycl::range<1>(N));
+    // 1) Création d'une queue SYCL sur le CPU
+    sycl::queue queue{ sycl::cpu_selector_v, fpga_tools::exception_handler };
+    std::cout << "Device utilisé : "
+    << queue.get_device().get_info<sycl::info::device::name>()
+    << " ["
+    << queue.get_device().get_info<sycl::info::device::vendor>()
+    << "]\n\n";
 
-        // 4) Création du plan DFT OneMKL (1D, double précision, domaine complexe->complexe)
-        auto descriptor = oneapi::mkl::dft::descriptor<
-        oneapi::mkl::dft::precision::DOUBLE,
-        oneapi::mkl::dft::domain::COMPLEX>{ N };
-        
-        // Spécifier que la FFT est in-place (les résultats remplaceront les données du buffer)
-        descriptor.commit(queue);
+    fpga_tools::cpu::FftPlanCache cache(queue);
+    bool ok = true;
+
+    // 2) Cas d'origine : rampe réelle de 64 points, double précision
+    {
+        const std::int64_t N = 64;
+        std::vector<std::complex<double>> x(N);
+        for (std::int64_t i = 0; i < N; ++i)
+            x[i] = std::complex<double>(static_cast<double>(i), 0.0);
 
-        // 5) Exécution de la FFT avant (forward)
-        //    compute_forward lancera la transformation sur le buffer en device
-        oneapi::mkl::dft::compute_forward(descriptor, buf);
+        std::complex<double>* data = sycl::malloc_shared<std::complex<double>>(N, queue);
+        std::copy(x.begin(), x.end(), data);
+        cache.forward(data, N, 1).wait();
 
-        // Lorsqu'on sort de ce bloc, le buffer sera synchronisé et les données dans 'data' seront mises à jour
+        const double ecart = ecartDft(x, data, N, 1);
+        ok &= ecart <= 1e-12;
+        std::cout << "Rampe 64 points : X[0] = " << data[0] << ", X[1] = " << data[1]
+                  << ", écart DFT " << ecart << "\n\n";
+        sycl::free(data, queue);
     }
 
-    // 6) Affichage des résultats (résultat de la FFT)
-    std::cout << "Résultat de la FFT (complexe) :\n";
-    for (std::int64_t i = 0; i < N; ++i) {
-        std::complex<double> c = data[i];
-        std::cout << "  [" << i << "] = " << c << "\n";
+    // 3) Débit par lots, plan en cache
+    std::cout << "     N     préc.    lot   1er appel(ms)  en cache(ms)   transformées/s   écart DFT\n";
+    for (int64_t N = 64; N <= 4096; N *= 4) {
+        ok &= mesure<float>(cache, queue, N, elements, 1e-5);
+        ok &= mesure<double>(cache, queue, N, elements, 1e-12);
     }
+    std::cout << "Plans committés : " << cache.nbCommits() << '\n';
 
-    return 0;
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
+    return ok ? 0 : 1;
 }
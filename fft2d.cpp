@@ -0,0 +1,140 @@
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include <oneapi/mkl.hpp>
+#include "exception_handler.hpp"
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "fft2d.hpp"
+
+// FFT 2D 1024 × 1024 (fft2d.hpp) sur une rafale de trames distance-Doppler
+// synthétiques, comparée à une FFT 2D oneMKL en double précision sur le CPU.
+// Usage : ./fft2d [nbTrames]   (défaut 4)
+
+constexpr int kLogRows = 10; // impulsions (Doppler)
+constexpr int kLogCols = 10; // cases distance
+constexpr double kFmaxMHz = 300.0; // pour la conversion en échantillons / cycle
+constexpr int Kbl1 = 1;            // scratch et sortie
+
+using Cfg = fpga_tools::FftFloat;
+using Moteur = fpga_tools::Fft2d<Cfg, kLogRows, kLogCols, 0, Kbl1, Kbl1>;
+using Data = Moteur::Data;
+
+// Référence oneMKL : frames FFT 2D rows × cols, en place, en un seul appel
+void referenceMkl2d(sycl::queue& qCpu, std::complex<double>* data,
+                    int64_t rows, int64_t cols, int64_t frames) {
+  oneapi::mkl::dft::descriptor<oneapi::mkl::dft::precision::DOUBLE,
+                               oneapi::mkl::dft::domain::COMPLEX> desc({rows, cols});
+  desc.set_value(oneapi::mkl::dft::config_param::NUMBER_OF_TRANSFORMS, frames);
+  desc.set_value(oneapi::mkl::dft::config_param::FWD_DISTANCE, rows * cols);
+  desc.set_value(oneapi::mkl::dft::config_param::BWD_DISTANCE, rows * cols);
+  desc.commit(qCpu);
+  oneapi::mkl::dft::compute_forward(desc, data).wait();
+}
+
+int main(int argc, char** argv) {
+  try {
+#if   FPGA_SIMULATOR
+    auto sel = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto sel = sycl::ext::intel::fpga_selector_v;
+#else
+    auto sel = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+    sycl::queue q(sel, fpga_tools::exception_handler,
+                  sycl::property::queue::enable_profiling{});
+    sycl::queue qCpu(sycl::cpu_selector_v, fpga_tools::exception_handler);
+
+    std::cout << "Device : "
+              << q.get_device().get_info<sycl::info::device::name>()
+              << ", référence oneMKL sur "
+              << qCpu.get_device().get_info<sycl::info::device::name>()
+              << '\n';
+
+    const int nbArg = argc > 1 ? std::atoi(argv[1]) : 4;
+    if (nbArg < 1) {
+      std::cerr << "Usage : " << argv[0] << " [nbTrames >= 1]\n";
+      return EXIT_FAILURE;
+    }
+    const uint32_t frames = uint32_t(nbArg);
+    constexpr uint32_t kR = Moteur::kRows, kC = Moteur::kCols;
+    constexpr size_t kFrame = Moteur::kFrame;
+    const size_t elements = kFrame * frames;
+
+    // Trois cibles (distance, Doppler) par trame, qui dérivent d'une trame à
+    // l'autre, plus du bruit
+    Data* src = sycl::malloc_host<Data>(elements, q);
+    Data* dst = sycl::malloc_shared<Data>(
+      elements, q,
+      {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl1)});
+    std::complex<double>* ref = sycl::malloc_shared<std::complex<double>>(elements, qCpu);
+    std::mt19937 g(2024);
+    std::uniform_real_distribution<double> bruit(-0.1, 0.1);
+    const double cibles[3][3] = {{100, 17, 0.3}, {411, -250, 0.2}, {803, 64, 0.1}};
+    for (uint32_t f = 0; f < frames; ++f)
+      for (uint32_t r = 0; r < kR; ++r)
+        for (uint32_t c = 0; c < kC; ++c) {
+          std::complex<double> x(bruit(g), bruit(g));
+          for (const auto& t : cibles)
+            x += t[2] * std::polar(1.0, 2 * fpga_tools::kPi *
+                                            ((t[0] + f) * c / kC + (t[1] + 3 * f) * r / kR));
+          const size_t i = f * kFrame + size_t(r) * kC + c;
+          src[i] = Data(float(x.real()), float(x.imag()));
+          ref[i] = {src[i].r(), src[i].i()};
+        }
+
+    Moteur fft;
+    fft.alloc(q);
+    std::vector<sycl::event> fin(frames);
+    for (uint32_t f = 0; f < frames; ++f)
+      fin[f] = fft.submit(q, src + f * kFrame, dst + f * kFrame);
+    referenceMkl2d(qCpu, ref, kR, kC, frames);
+    q.wait();
+
+    // Sortie transposée : dst[c * kR + r] = X[r][c]
+    double errMax = 0.0, refMax = 0.0;
+    for (uint32_t f = 0; f < frames; ++f)
+      for (uint32_t r = 0; r < kR; ++r)
+        for (uint32_t c = 0; c < kC; ++c) {
+          const Data& y = dst[f * kFrame + size_t(c) * kR + r];
+          const std::complex<double>& x = ref[f * kFrame + size_t(r) * kC + c];
+          errMax = std::max(errMax, std::abs(std::complex<double>(y.r(), y.i()) - x));
+          refMax = std::max(refMax, std::abs(x));
+        }
+    const double relatif = errMax / refMax;
+    const double tol = 1e-5;
+    const bool ok = relatif <= tol;
+
+    // Débit en régime établi : écart entre fins de trames successives (la
+    // première trame porte seule la latence de remplissage)
+    auto finNs = [&](uint32_t f) {
+      return double(fin[f].get_profiling_info<sycl::info::event_profiling::command_end>());
+    };
+    const double periode =
+        frames > 1 ? (finNs(frames - 1) - finNs(0)) * 1e-9 / (frames - 1)
+                   : (finNs(0) - double(fin[0].get_profiling_info<
+                                        sycl::info::event_profiling::command_start>())) * 1e-9;
+    std::cout << kR << " x " << kC << ", " << frames << " trames, erreur max " << relatif
+              << " (tol " << tol << ")\n"
+              << "Débit : " << 1.0 / periode << " trames/s, "
+              << kFrame / (periode * kFmaxMHz * 1e6) << " échantillons/cycle à "
+              << kFmaxMHz << " MHz\n";
+
+    fft.free(q);
+    sycl::free(src, q);
+    sycl::free(dst, q);
+    sycl::free(ref, qCpu);
+
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const sycl::exception& e) {
+    std::cerr << "SYCL exception : " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
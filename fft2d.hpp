@@ -0,0 +1,108 @@
+#ifndef __FFT2D_HPP__
+#define __FFT2D_HPP__
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include <cstdint>
+
+#include "fft_sdf.hpp"
+#include "pipe_feeder.hpp"
+#include "transpose.hpp"
+
+// -----------------------------------------------------------------------------
+// FFT 2D (carte distance-Doppler) : FFT lignes -> corner turn -> FFT colonnes
+//
+//   src (hôte) -> PipeFeeder -> FftSdf (lignes, kCols points)
+//              -> TransposeStream (bandes de StripeRows lignes, on-chip)
+//              -> scratch DDR, déjà transposé : kCols colonnes de kRows
+//   scratch    -> PipeFeeder -> FftSdfMM (colonnes, kRows points) -> out
+//
+// Les lignes ne passent jamais en DDR dans l'ordre d'origine : la seule
+// mémoire intermédiaire est scratch, en deux moitiés alternées, de sorte que
+// l'étage lignes de la trame f + 1 tourne pendant l'étage colonnes de la
+// trame f. En régime établi chaque étage traite un échantillon par cycle :
+// TransposeStream écrit la bande a-1 pendant qu'il reçoit la bande a ; il ne
+// perd que l'entrée de boucle de chaque bande et l'écriture seule de la
+// dernière (kCols cycles), soit environ 1 / kRows de la trame.
+//
+// Sortie transposée : out[kc * kRows + kr] = X[kr][kc], kc l'indice de la FFT
+// lignes (distance), kr celui de la FFT colonnes (Doppler).
+// Avec FftFixed la sortie vaut X / (kRows · kCols).
+// out doit être alloué dans la banque BlOut (interface de FftSdfMM).
+// -----------------------------------------------------------------------------
+
+namespace fpga_tools {
+
+template <int Id> class Fft2dFeederL;
+template <int Id> class Fft2dLignes;
+template <int Id> class Fft2dCoin;
+template <int Id> class Fft2dFeederC;
+template <int Id> class Fft2dColonnes;
+template <int Id, int P> class Fft2dPipe;
+
+template <typename Cfg, int LogRows, int LogCols,
+          int Id = 0,
+          int BlScratch = 1,
+          int BlOut = 1,
+          int StripeRows = 32>
+struct Fft2d {
+  using Data = ac_complex<typename Cfg::Elem>;
+  static constexpr uint32_t kRows = 1u << LogRows;
+  static constexpr uint32_t kCols = 1u << LogCols;
+  static constexpr size_t kFrame = size_t(kRows) * kCols;
+  static_assert(kRows % StripeRows == 0, "kRows doit être un multiple de StripeRows");
+
+  using pipe_props = decltype(sycl::ext::oneapi::experimental::properties(
+      sycl::ext::intel::experimental::ready_latency<0>));
+  using PipeLignes = sycl::ext::intel::experimental::pipe<
+      Fft2dPipe<Id, 0>, Data, 0, pipe_props>;
+  using PipeCoin = sycl::ext::intel::experimental::pipe<
+      Fft2dPipe<Id, 1>, WideBeat<Data, 1>, 0, pipe_props>;
+  using PipeColonnes = sycl::ext::intel::experimental::pipe<
+      Fft2dPipe<Id, 2>, Data, 0, pipe_props>;
+
+  Data* scratch = nullptr; // 2 trames kCols × kRows
+  uint64_t nbTrames = 0;
+  sycl::event relu[2];     // fin de relecture de chaque moitié de scratch
+
+  void alloc(sycl::queue& q) {
+    scratch = sycl::malloc_device<Data>(
+        2 * kFrame, q,
+        {sycl::ext::intel::experimental::property::usm::buffer_location(BlScratch)});
+  }
+
+  // Enfile une trame kRows × kCols (row-major) sans attendre ; l'événement
+  // rendu marque la fin de l'écriture de out
+  sycl::event submit(sycl::queue& q, Data* src, Data* out) {
+    Data* s = scratch + (nbTrames % 2) * kFrame;
+    sycl::event& libre = relu[nbTrames % 2];
+
+    // Étage lignes : l'alimentation et la FFT lignes ne touchent pas scratch
+    // et partent tout de suite ; seul TransposeStream, qui écrit la moitié s,
+    // attend la fin de sa relecture
+    q.single_task<Fft2dFeederL<Id>>(PipeFeeder<PipeLignes, Data>{src, kFrame});
+    q.single_task<Fft2dLignes<Id>>(
+        FftSdf<PipeLignes, PipeCoin, Cfg, LogCols, WideBeat<Data, 1>>{kRows});
+    sycl::event coin = q.submit([&](sycl::handler& h) {
+      h.depends_on(libre);
+      h.single_task<Fft2dCoin<Id>>(
+          TransposeStream<PipeCoin, Data, StripeRows, kCols, 512, BlScratch>{s, kRows, kCols});
+    });
+
+    // Étage colonnes : une fois la trame entièrement transposée
+    libre = q.submit([&](sycl::handler& h) {
+      h.depends_on(coin);
+      h.single_task<Fft2dFeederC<Id>>(PipeFeeder<PipeColonnes, Data>{s, kFrame});
+    });
+    nbTrames++;
+    return q.submit([&](sycl::handler& h) {
+      h.depends_on(coin);
+      h.single_task<Fft2dColonnes<Id>>(FftSdfMM<PipeColonnes, Cfg, LogRows, BlOut>{out, kCols});
+    });
+  }
+
+  void free(sycl::queue& q) { sycl::free(scratch, q); }
+};
+
+} // namespace fpga_tools
+
+#endif //__FFT2D_HPP__
@@ -0,0 +1,105 @@
+#ifndef __FFT_CPU_HPP__
+#define __FFT_CPU_HPP__
+#include <sycl/sycl.hpp>
+#include <oneapi/mkl.hpp>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// FFT complexes par lots avec oneMKL (repli CPU de fft_sdf.hpp)
+//
+// Un descripteur oneMKL coûte cher à créer et à committer : FftPlanCache les
+// garde, indexés par (taille, précision, nombre de transformées, distance).
+// Après le premier appel, une exécution de batch transformées ne coûte plus
+// que compute_forward.
+//
+// Interface USM, en place : batch transformées de n points, la transformée b
+// commençant à data + b * distance (distance = 0 : n, trames contiguës).
+// float ou double selon le type de data.
+// -----------------------------------------------------------------------------
+
+namespace fpga_tools {
+namespace cpu {
+
+class FftPlanCache {
+ public:
+  explicit FftPlanCache(sycl::queue& q) : q_(q) {}
+
+  template <typename Real>
+  sycl::event forward(std::complex<Real>* data, int64_t n, int64_t batch,
+                      int64_t distance = 0, const std::vector<sycl::event>& deps = {}) {
+    return oneapi::mkl::dft::compute_forward(plan<Real>(n, batch, distance), data, deps);
+  }
+
+  template <typename Real>
+  sycl::event backward(std::complex<Real>* data, int64_t n, int64_t batch,
+                       int64_t distance = 0, const std::vector<sycl::event>& deps = {}) {
+    return oneapi::mkl::dft::compute_backward(plan<Real>(n, batch, distance), data, deps);
+  }
+
+  // Nombre de plans créés (= commits) depuis la construction
+  size_t nbCommits() const { return nbCommits_; }
+  void clear() {
+    std::lock_guard<std::mutex> verrou(m_);
+    simple_.clear();
+    double_.clear();
+  }
+
+ private:
+  template <oneapi::mkl::dft::precision P>
+  using Descripteur = oneapi::mkl::dft::descriptor<P, oneapi::mkl::dft::domain::COMPLEX>;
+
+  // (n, batch, distance) ; la précision choisit la table
+  using Cle = std::tuple<int64_t, int64_t, int64_t>;
+
+  template <oneapi::mkl::dft::precision P>
+  using Table = std::map<Cle, std::unique_ptr<Descripteur<P>>>;
+
+  template <typename Real>
+  auto& plan(int64_t n, int64_t batch, int64_t distance) {
+    static_assert(std::is_same_v<Real, float> || std::is_same_v<Real, double>,
+                  "précision float ou double");
+    constexpr auto P = std::is_same_v<Real, float> ? oneapi::mkl::dft::precision::SINGLE
+                                                   : oneapi::mkl::dft::precision::DOUBLE;
+    if (distance == 0)
+      distance = n;
+
+    std::lock_guard<std::mutex> verrou(m_);
+    auto& table = table_<P>();
+    auto& d = table[Cle{n, batch, distance}];
+    if (!d) {
+      d = std::make_unique<Descripteur<P>>(n);
+      d->set_value(oneapi::mkl::dft::config_param::NUMBER_OF_TRANSFORMS, batch);
+      d->set_value(oneapi::mkl::dft::config_param::FWD_DISTANCE, distance);
+      d->set_value(oneapi::mkl::dft::config_param::BWD_DISTANCE, distance);
+      d->commit(q_);
+      nbCommits_++;
+    }
+    return *d;
+  }
+
+  template <oneapi::mkl::dft::precision P>
+  Table<P>& table_() {
+    if constexpr (P == oneapi::mkl::dft::precision::SINGLE)
+      return simple_;
+    else
+      return double_;
+  }
+
+  sycl::queue& q_;
+  std::mutex m_;
+  Table<oneapi::mkl::dft::precision::SINGLE> simple_;
+  Table<oneapi::mkl::dft::precision::DOUBLE> double_;
+  size_t nbCommits_ = 0;
+};
+
+} // namespace cpu
+} // namespace fpga_tools
+
+#endif //__FFT_CPU_HPP__
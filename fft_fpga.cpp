@@ -0,0 +1,144 @@
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include <oneapi/mkl.hpp>
+#include "exception_handler.hpp"
+
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "fft_sdf.hpp"
+#include "pipe_feeder.hpp"
+
+// FFT radix-2² SDF sur FPGA (fft_sdf.hpp), comparée à oneMKL en double
+// précision sur le CPU : variante pipe -> pipe (ordre naturel via un kernel
+// puits) et variante pipe -> mémoire, en float et en virgule fixe 18 bits.
+
+template <int Id> class FeederKernel;
+template <int Id> class FftKernel;
+template <int Id> class SinkKernel;
+template <int Id, int P> class IdPipe;
+
+// Banque de sortie, celle de l'interface out de FftSdfMM
+constexpr int Kbl1 = 1;
+
+using pipe_props = decltype(
+    sycl::ext::oneapi::experimental::properties(
+        sycl::ext::intel::experimental::ready_latency<0>));
+
+inline double toDouble(float v) { return v; }
+template <int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+inline double toDouble(const ac_fixed<W, I, S, Q, O>& v) { return v.to_double(); }
+
+// Référence oneMKL : frames FFT de N points, en place, en un seul appel
+void referenceMkl(sycl::queue& qCpu, std::complex<double>* data, int64_t n, int64_t frames) {
+  oneapi::mkl::dft::descriptor<oneapi::mkl::dft::precision::DOUBLE,
+                               oneapi::mkl::dft::domain::COMPLEX> desc(n);
+  desc.set_value(oneapi::mkl::dft::config_param::NUMBER_OF_TRANSFORMS, frames);
+  desc.set_value(oneapi::mkl::dft::config_param::FWD_DISTANCE, n);
+  desc.set_value(oneapi::mkl::dft::config_param::BWD_DISTANCE, n);
+  desc.commit(qCpu);
+  oneapi::mkl::dft::compute_forward(desc, data).wait();
+}
+
+template <typename Cfg, int LogN, bool SortiePipe, int Id>
+bool testFft(sycl::queue& q, sycl::queue& qCpu, uint32_t frames, double tol, const char* nom) {
+  using Elem = typename Cfg::Elem;
+  using Data = ac_complex<Elem>;
+  constexpr uint32_t kN = 1u << LogN;
+  const size_t elements = size_t(kN) * frames;
+
+  using InPipe  = sycl::ext::intel::experimental::pipe<IdPipe<Id, 0>, Data, 0, pipe_props>;
+  using OutPipe = sycl::ext::intel::experimental::pipe<IdPipe<Id, 1>, Data, 0, pipe_props>;
+  using Feeder  = fpga_tools::PipeFeeder<InPipe, Data>;
+
+  // Deux raies et du bruit, parties dans ]-1, 1[
+  Data* src = sycl::malloc_host<Data>(elements, q);
+  Data* dst = sycl::malloc_shared<Data>(
+    elements, q,
+    {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl1)});
+  std::complex<double>* ref = sycl::malloc_shared<std::complex<double>>(elements, qCpu);
+  std::mt19937 g(Id);
+  std::uniform_real_distribution<double> bruit(-0.2, 0.2);
+  for (size_t t = 0; t < elements; ++t) {
+    const double n = double(t % kN);
+    const std::complex<double> x = 0.3 * std::polar(1.0, 2 * fpga_tools::kPi * 37 * n / kN) +
+                                   0.2 * std::polar(1.0, -2 * fpga_tools::kPi * (t / kN + 5) * n / kN) +
+                                   std::complex<double>(bruit(g), bruit(g));
+    src[t] = Data(Elem(x.real()), Elem(x.imag()));
+    ref[t] = {toDouble(src[t].r()), toDouble(src[t].i())}; // entrée quantifiée
+  }
+
+  q.single_task<FeederKernel<Id>>(Feeder{src, elements});
+  if constexpr (SortiePipe) {
+    q.single_task<FftKernel<Id>>(fpga_tools::FftSdf<InPipe, OutPipe, Cfg, LogN>{frames});
+    q.single_task<SinkKernel<Id>>([=]() {
+      for (size_t t = 0; t < elements; t++)
+        dst[t] = OutPipe::read();
+    });
+  } else {
+    q.single_task<FftKernel<Id>>(fpga_tools::FftSdfMM<InPipe, Cfg, LogN, Kbl1>{dst, frames});
+  }
+  referenceMkl(qCpu, ref, kN, frames);
+  q.wait();
+
+  // FftFixed sort X[k] / N
+  const double echelle = std::is_same_v<Cfg, fpga_tools::FftFloat> ? 1.0 : double(kN);
+  double errMax = 0.0, refMax = 0.0, puissErr = 0.0, puissRef = 0.0;
+  for (size_t t = 0; t < elements; ++t) {
+    const std::complex<double> y(toDouble(dst[t].r()) * echelle, toDouble(dst[t].i()) * echelle);
+    errMax = std::max(errMax, std::abs(y - ref[t]));
+    refMax = std::max(refMax, std::abs(ref[t]));
+    puissErr += std::norm(y - ref[t]);
+    puissRef += std::norm(ref[t]);
+  }
+  const double relatif = errMax / refMax;
+  const bool ok = relatif <= tol;
+
+  std::cout << nom << " : N = " << kN << ", " << frames << " trames, erreur max "
+            << relatif << " (tol " << tol << "), SNR "
+            << 10.0 * std::log10(puissRef / puissErr) << " dB "
+            << (ok ? "OK" : "KO") << '\n';
+
+  sycl::free(src, q);
+  sycl::free(dst, q);
+  sycl::free(ref, qCpu);
+  return ok;
+}
+
+int main() {
+  try {
+#if   FPGA_SIMULATOR
+    auto sel = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto sel = sycl::ext::intel::fpga_selector_v;
+#else
+    auto sel = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+    sycl::queue q(sel, fpga_tools::exception_handler);
+    sycl::queue qCpu(sycl::cpu_selector_v, fpga_tools::exception_handler);
+
+    std::cout << "Device : "
+              << q.get_device().get_info<sycl::info::device::name>()
+              << ", référence oneMKL sur "
+              << qCpu.get_device().get_info<sycl::info::device::name>()
+              << '\n';
+
+    using fpga_tools::FftFloat;
+    using fpga_tools::FftFixed;
+    bool ok = true;
+    ok &= testFft<FftFloat, 10, true, 0>(q, qCpu, 8, 1e-5, "float   pipe   ");
+    ok &= testFft<FftFloat, 7, false, 1>(q, qCpu, 8, 1e-5, "float   mémoire");
+    ok &= testFft<FftFixed<18>, 6, true, 2>(q, qCpu, 8, 1e-3, "ac_fixed pipe  ");
+    ok &= testFft<FftFixed<18>, 12, false, 3>(q, qCpu, 4, 1e-3, "ac_fixed mémoire");
+
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const sycl::exception& e) {
+    std::cerr << "SYCL exception : " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
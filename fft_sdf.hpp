@@ -0,0 +1,323 @@
+#ifndef __FFT_SDF_HPP__
+#define __FFT_SDF_HPP__
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include <sycl/ext/intel/ac_types/ac_complex.hpp>
+#include <sycl/ext/intel/ac_types/ac_fixed.hpp>
+#include <cstdint>
+
+// -----------------------------------------------------------------------------
+// FFT en flux radix-2² SDF (single-path delay feedback), un échantillon par
+// cycle, taille N = 2^LogN (64 .. 4096) fixée à la compilation.
+//
+// Chaque paire d'étages comprend BF2I (délai L), BF2II (délai L/2, rotation
+// triviale -j) et un seul multiplieur complexe. Ses twiddles W_2L^e sont dans
+// une ROM calculée à la compilation. Pour LogN impair, un dernier étage radix-2
+// seul termine la chaîne.
+// Tous les compteurs d'étage se déduisent du compteur global i : les délais
+// cumulés sont des multiples des périodes d'étage.
+//
+// Sortie d'un cœur SDF : ordre bit-inversé, latence N - 1 échantillons. La
+// dernière trame est vidée en poussant N - 1 zéros.
+//   – FftSdf   : pipe -> pipe, remise en ordre naturel par un double buffer
+//                de N (latence totale 2N - 1)
+//   – FftSdfMM : pipe -> mémoire, écriture directe à l'adresse bit-inversée
+//
+// Deux arithmétiques (Cfg) :
+//   – FftFloat    : ac_complex<float>, X[k] = Σ x[n] W_N^nk
+//   – FftFixed<W> : ac_complex<ac_fixed<W, 2>>, chaque papillon divise par 2
+//                   pour rester dans la dynamique : sortie X[k] / N
+// -----------------------------------------------------------------------------
+
+namespace fpga_tools {
+
+// ---------- Arithmétiques -----------------------------------------------------
+// Elem  : type d'une partie, Raw : codage d'un coefficient dans la ROM
+// code  : coefficient réel -> Raw (à la compilation), coef : Raw -> Elem
+// reduit: résultat d'une somme / différence de papillon -> Elem
+struct FftFloat {
+  using Elem = float;
+  using Raw = float;
+  static constexpr Raw code(double v) { return float(v); }
+  static Elem coef(Raw r) { return r; }
+  template <typename X> static Elem reduit(const X& x) { return Elem(x); }
+};
+
+template <int W = 18>
+struct FftFixed {
+  // 2 bits entiers : |partie| <= |échantillon| <= sqrt(2) avec la division
+  // par 2 à chaque papillon, et le twiddle 1.0 est représentable
+  using Elem = ac_fixed<W, 2, true, AC_RND, AC_SAT>;
+  using Raw = int32_t;
+  static constexpr Raw code(double v) {
+    return Raw(v * double(1 << (W - 2)) + (v >= 0 ? 0.5 : -0.5));
+  }
+  static Elem coef(Raw r) {
+    Elem e;
+    e.set_slc(0, ac_int<W, true>(r));
+    return e;
+  }
+  template <typename X> static Elem reduit(const X& x) {
+    return Elem(x * ac_fixed<1, 0, false>(0.5));
+  }
+};
+
+// ---------- Twiddles calculés à la compilation --------------------------------
+constexpr double kPi = 3.14159265358979323846;
+
+// Séries de Taylor sur [0, π/4] : précision double en 14 termes
+constexpr double sinTaylor(double x) {
+  double t = x, s = x;
+  for (int k = 1; k < 14; k++) {
+    t *= -x * x / double((2 * k) * (2 * k + 1));
+    s += t;
+  }
+  return s;
+}
+constexpr double cosTaylor(double x) {
+  double t = 1.0, s = 1.0;
+  for (int k = 1; k < 14; k++) {
+    t *= -x * x / double((2 * k - 1) * (2 * k));
+    s += t;
+  }
+  return s;
+}
+
+// cos / sin de 2π k / n, réduits au premier octant par symétrie
+constexpr void cosSinTour(uint32_t k, uint32_t n, double& c, double& s) {
+  k %= n;
+  const uint32_t quadrant = uint32_t(uint64_t(4) * k / n);
+  const uint32_t r = uint32_t(uint64_t(4) * k % n); // angle (π/2) r / n
+  double c0 = 0.0, s0 = 0.0;
+  if (2 * r <= n) {
+    const double x = kPi / 2 * double(r) / double(n);
+    c0 = cosTaylor(x);
+    s0 = sinTaylor(x);
+  } else {
+    const double x = kPi / 2 * double(n - r) / double(n);
+    c0 = sinTaylor(x);
+    s0 = cosTaylor(x);
+  }
+  switch (quadrant) {
+    case 0: c = c0;  s = s0;  break;
+    case 1: c = -s0; s = c0;  break;
+    case 2: c = -c0; s = -s0; break;
+    default: c = s0; s = -c0; break;
+  }
+}
+
+// W_2L^e = exp(-2jπ e / 2L), e < 3L/2 (exposants utiles d'une paire)
+template <typename Cfg, int L>
+struct TwiddleRom {
+  static constexpr int kTaille = 3 * L / 2;
+  typename Cfg::Raw re[kTaille];
+  typename Cfg::Raw im[kTaille];
+  constexpr TwiddleRom() : re(), im() {
+    for (int e = 0; e < kTaille; e++) {
+      double c = 0.0, s = 0.0;
+      cosSinTour(uint32_t(e), uint32_t(2 * L), c, s);
+      re[e] = Cfg::code(c);
+      im[e] = Cfg::code(-s);
+    }
+  }
+};
+
+template <typename Cfg, int L>
+inline constexpr TwiddleRom<Cfg, L> kTwiddle{};
+
+// ---------- Ligne à retard ----------------------------------------------------
+// FIFO de L éléments, une entrée et une sortie par cycle : front() est
+// l'élément entré L décalages plus tôt. Registres à décalage pour les petits
+// délais, mémoire circulaire au-delà.
+constexpr int kDelaiRegistres = 16;
+
+template <typename T, int L, bool Ram = (L > kDelaiRegistres)>
+struct DelayLine {
+  T r[L];
+  T front() const { return r[L - 1]; }
+  void shift(const T& x) {
+    #pragma unroll
+    for (int k = L - 1; k > 0; k--)
+      r[k] = r[k - 1];
+    r[0] = x;
+  }
+};
+
+template <typename T, int L>
+struct DelayLine<T, L, true> {
+  static_assert((L & (L - 1)) == 0, "L doit être une puissance de 2");
+  T m[L];
+  uint32_t idx = 0;
+  T front() const { return m[idx]; }
+  void shift(const T& x) {
+    m[idx] = x;
+    idx = (idx + 1) & (L - 1);
+  }
+};
+
+// ---------- Papillon SDF ------------------------------------------------------
+// Première moitié du bloc de 2L : on range a et on sort la différence du bloc
+// précédent ; seconde moitié : on sort a + x et on range a - x.
+template <typename Cfg, int L>
+struct Bf2 {
+  using Data = ac_complex<typename Cfg::Elem>;
+  DelayLine<Data, L> d;
+
+  Data step(const Data& x, bool second) {
+    const Data a = d.front();
+    const Data somme(Cfg::reduit(a.r() + x.r()), Cfg::reduit(a.i() + x.i()));
+    const Data diff(Cfg::reduit(a.r() - x.r()), Cfg::reduit(a.i() - x.i()));
+    d.shift(second ? diff : x);
+    return second ? somme : a;
+  }
+};
+
+// ---------- Paires d'étages ---------------------------------------------------
+// L : délai du BF2I de la paire ; la paire suivante a un délai L / 4
+template <typename Cfg, int L>
+struct SdfEtages {
+  using Elem = typename Cfg::Elem;
+  using Data = ac_complex<Elem>;
+  Bf2<Cfg, L> bf1;
+  Bf2<Cfg, L / 2> bf2;
+  SdfEtages<Cfg, L / 4> suite;
+
+  Data step(const Data& x, uint32_t i) {
+    Data v = bf1.step(x, i & L);
+
+    // -j sur le dernier quart de la période 2L, vue de l'entrée du BF2II
+    if (((i + L) & (2 * L - 1)) >= 3 * L / 2)
+      v = Data(v.i(), Elem(-v.r()));
+    v = bf2.step(v, i & (L / 2));
+
+    // W_2L^(j (c + 2d)), position u vue de la sortie du BF2II
+    if constexpr (L > 2) {
+      const uint32_t u = (i + L / 2) & (2 * L - 1);
+      const uint32_t c = (u & L) ? 1 : 0;
+      const uint32_t d = (u & (L / 2)) ? 2 : 0;
+      const uint32_t e = (u & (L / 2 - 1)) * (c + d);
+      const Data w(Cfg::coef(kTwiddle<Cfg, L>.re[e]), Cfg::coef(kTwiddle<Cfg, L>.im[e]));
+      v = Data(Elem(v.r() * w.r() - v.i() * w.i()), Elem(v.r() * w.i() + v.i() * w.r()));
+    }
+    return suite.step(v, i);
+  }
+};
+
+// LogN impair : dernier étage radix-2 seul
+template <typename Cfg>
+struct SdfEtages<Cfg, 1> {
+  using Data = ac_complex<typename Cfg::Elem>;
+  Bf2<Cfg, 1> bf1;
+  Data step(const Data& x, uint32_t i) { return bf1.step(x, i & 1); }
+};
+
+template <typename Cfg>
+struct SdfEtages<Cfg, 0> {
+  using Data = ac_complex<typename Cfg::Elem>;
+  Data step(const Data& x, uint32_t) { return x; }
+};
+
+template <int LogN>
+inline uint32_t bitReverse(uint32_t k) {
+  uint32_t r = 0;
+  #pragma unroll
+  for (int b = 0; b < LogN; b++)
+    r |= ((k >> b) & 1) << (LogN - 1 - b);
+  return r;
+}
+
+template <typename Cfg, int LogN>
+struct SdfCore {
+  static_assert(LogN >= 6 && LogN <= 12, "N = 64 .. 4096");
+  static constexpr uint32_t kN = 1u << LogN;
+  static constexpr uint32_t kLatence = kN - 1;
+  using Data = ac_complex<typename Cfg::Elem>;
+
+  SdfEtages<Cfg, kN / 2> etages;
+  Data step(const Data& x, uint32_t i) { return etages.step(x, i); }
+};
+
+// -----------------------------------------------------------------------------
+// FFT pipe -> pipe, frames trames de N échantillons, sortie en ordre naturel
+// OutBeat : type du pipe de sortie, construit par OutBeat{y} (Data ou
+// WideBeat<Data, 1> pour alimenter TransposeStream)
+// -----------------------------------------------------------------------------
+template <typename InPipe, typename OutPipe, typename Cfg, int LogN,
+          typename OutBeat = ac_complex<typename Cfg::Elem>>
+struct FftSdf {
+  using Core = SdfCore<Cfg, LogN>;
+  using Data = typename Core::Data;
+  static constexpr uint32_t kN = Core::kN;
+
+  sycl::ext::oneapi::experimental::annotated_arg<
+      uint32_t, decltype(sycl::ext::oneapi::experimental::properties{
+                    sycl::ext::intel::experimental::conduit})>
+      frames;
+
+  void operator()() const {
+    Core core;
+    // Remise en ordre : la trame f est écrite bit-inversée dans ordre[f % 2]
+    // pendant que la trame f - 1 est relue en ordre naturel dans l'autre moitié
+    [[intel::numbanks(2),intel::max_replicates(1)]] Data ordre[2][kN];
+
+    const uint64_t nIn = uint64_t(frames) * kN;
+    const uint64_t total = nIn + Core::kLatence + kN;
+
+    [[intel::initiation_interval(1),intel::ivdep(kDelaiRegistres)]]
+    for (uint64_t i = 0; i < total; i++) {
+      const Data x = i < nIn ? InPipe::read() : Data(0, 0);
+      const Data y = core.step(x, uint32_t(i));
+
+      if (i >= Core::kLatence) {
+        const uint64_t o = i - Core::kLatence;
+        if (o < nIn)
+          ordre[(o / kN) & 1][bitReverse<LogN>(uint32_t(o % kN))] = y;
+        if (o >= kN) {
+          const uint64_t r = o - kN;
+          OutPipe::write(OutBeat{ordre[(r / kN) & 1][r % kN]});
+        }
+      }
+    }
+  }
+};
+
+// -----------------------------------------------------------------------------
+// FFT pipe -> mémoire : trame f en out[f N .. f N + N - 1], ordre naturel
+// -----------------------------------------------------------------------------
+template <typename InPipe, typename Cfg, int LogN, int BlOut = 1>
+struct FftSdfMM {
+  using Core = SdfCore<Cfg, LogN>;
+  using Data = typename Core::Data;
+  static constexpr uint32_t kN = Core::kN;
+
+  sycl::ext::oneapi::experimental::annotated_arg<
+      Data*, decltype(sycl::ext::oneapi::experimental::properties{
+                 sycl::ext::intel::experimental::buffer_location<BlOut>,
+                 sycl::ext::intel::experimental::read_write_mode_write})>
+      out;
+  sycl::ext::oneapi::experimental::annotated_arg<
+      uint32_t, decltype(sycl::ext::oneapi::experimental::properties{
+                    sycl::ext::intel::experimental::conduit})>
+      frames;
+
+  void operator()() const {
+    Core core;
+    const uint64_t nIn = uint64_t(frames) * kN;
+    const uint64_t total = nIn + Core::kLatence;
+
+    [[intel::initiation_interval(1),intel::ivdep(kDelaiRegistres)]]
+    for (uint64_t i = 0; i < total; i++) {
+      const Data x = i < nIn ? InPipe::read() : Data(0, 0);
+      const Data y = core.step(x, uint32_t(i));
+
+      if (i >= Core::kLatence) {
+        const uint64_t o = i - Core::kLatence;
+        out[(o / kN) * kN + bitReverse<LogN>(uint32_t(o % kN))] = y;
+      }
+    }
+  }
+};
+
+} // namespace fpga_tools
+
+#endif //__FFT_SDF_HPP__
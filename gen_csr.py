@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+"""Génère un en-tête C typé à partir de la carte CSR d'un IP oneAPI.
+
+Le compilateur écrit, pour chaque kernel à interface CSR,
+<cible>.prj/include/kernel_headers/<kernel>_register_map.hpp : une suite de
+#define <KERNEL>_REGISTER_MAP_<NOM> (<valeur>). Ce script les relit et produit
+un seul en-tête C (Nios II ou hôte) où chaque kernel reçoit un préfixe choisi :
+
+    <P>_STATUS_OFF, <P>_START_OFF, <P>_IRQ_ENABLE_OFF, ...   registres de contrôle
+    <P>_ARG_<ARG>_OFF / <P>_ARG_<ARG>_SIZE                     arguments
+    <P>_<NOM>                                                  autres constantes
+    <p>_set_<arg>(base, v), <p>_start(base), <p>_status(base)  accès typés
+
+Les offsets ne sont donc plus recopiés à la main dans le pilote : il suffit de
+relancer le script (cible cmake csr_header) après chaque révision du kernel.
+
+Usage :
+    gen_csr.py <cible>.prj [--kernel NOM=PREFIXE ...] [--need PREFIXE=ARG,...]
+               -o transpose_csr.h
+    gen_csr.py a_register_map.hpp b_register_map.hpp -o csr.h
+Sans --kernel, chaque kernel prend pour préfixe le nom de son fichier.
+NOM est le nom complet du kernel (jokers * ? admis) : Transpose ne désigne pas
+TransposeRing. --need échoue si le kernel n'a pas ces arguments en registres
+CSR (p. ex. un argument passé en conduit), plutôt que de laisser le pilote
+retomber sur des offsets codés en dur.
+"""
+
+import argparse
+import fnmatch
+import glob
+import os
+import re
+import sys
+
+DEFINE = re.compile(r"^\s*#\s*define\s+(\w+?)_REGISTER_MAP_(\w+)\s+(.+?)\s*(?://.*|/\*.*)?$")
+EXPR = re.compile(r"^[0-9a-fA-FxX()<>|&+\-*~ ]+$")
+
+# Registres de contrôle : nom oneAPI -> nom court du pilote
+CONTROLE = {
+    "STATUS": "STATUS",
+    "START": "START",
+    "INTERRUPT_ENABLE": "IRQ_ENABLE",
+    "INTERRUPT_STATUS": "IRQ_STATUS",
+    "FINISH_COUNTER": "FINISH_CNT",
+}
+
+C_TYPES = {1: "uint8_t", 2: "uint16_t", 4: "uint32_t", 8: "uint64_t"}
+
+
+def valeur(texte, fichier, nom):
+    v = re.sub(r"(?<=[0-9a-fA-F])[uUlL]+\b", "", texte.strip())
+    if not EXPR.match(v):
+        raise SystemExit(f"{fichier} : valeur non reconnue pour {nom} : {texte}")
+    return int(eval(v, {"__builtins__": {}}, {}))  # entiers et opérateurs seuls
+
+
+def nom_argument(nom):
+    # ARG_ARG_IN -> IN : oneAPI préfixe les arguments, parfois deux fois
+    while nom.startswith("ARG_"):
+        nom = nom[4:]
+    return nom
+
+
+def nom_kernel(base):
+    # _ZTS13TransposeCsrIP -> TransposeCsrIP : nom de type éventuellement mangé
+    m = re.match(r"^_?ZTS\d+(\w+)$", base)
+    return m.group(1) if m else base
+
+
+def lire_carte(fichier):
+    """Rend (controle, args, autres) : dictionnaires nom -> valeur."""
+    controle, offsets, tailles, autres = {}, {}, {}, {}
+    with open(fichier, encoding="utf-8", errors="replace") as f:
+        for ligne in f:
+            m = DEFINE.match(ligne)
+            if not m:
+                continue
+            nom, v = m.group(2), valeur(m.group(3), fichier, m.group(2))
+            if nom.startswith("ARG_") and nom.endswith("_REG"):
+                offsets[nom_argument(nom[:-4])] = v
+            elif nom.startswith("ARG_") and nom.endswith("_SIZE"):
+                tailles[nom_argument(nom[:-5])] = v
+            elif nom.endswith("_REG") and nom[:-4] in CONTROLE:
+                controle[CONTROLE[nom[:-4]]] = v
+            else:
+                autres[nom] = v
+
+    # Taille manquante : écart avec l'argument suivant, au plus 8 octets ;
+    # 4 pour le dernier, plutôt que d'écrire au-delà de la carte
+    args = []
+    ordre = sorted(offsets.items(), key=lambda kv: kv[1])
+    for i, (nom, off) in enumerate(ordre):
+        taille = tailles.get(nom)
+        if taille is None:
+            suivant = ordre[i + 1][1] if i + 1 < len(ordre) else off + 4
+            taille = min(8, suivant - off)
+            print(f"{fichier} : pas de taille pour {nom}, {taille} octets supposés",
+                  file=sys.stderr)
+        if taille not in C_TYPES:
+            raise SystemExit(f"{fichier} : taille {taille} non gérée pour l'argument {nom}")
+        args.append((nom, off, taille))
+    return controle, args, autres
+
+
+def generer(kernels, sortie):
+    garde = "__" + re.sub(r"\W", "_", os.path.basename(sortie)).upper() + "__"
+    out = []
+    w = out.append
+    w("/* Généré par gen_csr.py — ne pas éditer, relancer le script.")
+    for prefixe, fichier, _ in kernels:
+        w(f" *   {prefixe:<16} <- {os.path.basename(fichier)}")
+    w(" */")
+    w(f"#ifndef {garde}")
+    w(f"#define {garde}")
+    w("")
+    w("#include <stdint.h>")
+    w("#include <io.h>            /* IOWR_*DIRECT / IORD_*DIRECT (HAL ou csr_sim) */")
+
+    for prefixe, fichier, (controle, args, autres) in kernels:
+        p = prefixe.lower()
+        w("")
+        w(f"/* ---------- {prefixe} " + "-" * max(4, 62 - len(prefixe)) + " */")
+        for nom, v in sorted(controle.items(), key=lambda kv: kv[1]):
+            w(f"#define {prefixe}_{nom}_OFF".ljust(44) + f" 0x{v:02X}")
+        for nom, off, taille in args:
+            w(f"#define {prefixe}_ARG_{nom}_OFF".ljust(44) + f" 0x{off:02X}")
+            w(f"#define {prefixe}_ARG_{nom}_SIZE".ljust(44) + f" {taille}")
+        for nom, v in sorted(autres.items()):
+            w(f"#define {prefixe}_{nom}".ljust(44) + f" 0x{v:X}")
+        w("")
+
+        for nom, off, taille in args:
+            t = C_TYPES[taille]
+            w(f"static inline void {p}_set_{nom.lower()}(uint32_t base, {t} v)")
+            w("{")
+            if taille == 8:
+                w(f"    IOWR_32DIRECT(base, {prefixe}_ARG_{nom}_OFF,      (uint32_t)v);")
+                w(f"    IOWR_32DIRECT(base, {prefixe}_ARG_{nom}_OFF + 4U, (uint32_t)(v >> 32));")
+            else:
+                w(f"    IOWR_{taille * 8}DIRECT(base, {prefixe}_ARG_{nom}_OFF, v);")
+            w("}")
+        if "START" in controle:
+            w("/* Start : flanc montant */")
+            w(f"static inline void {p}_start(uint32_t base)")
+            w("{")
+            w(f"    IOWR_32DIRECT(base, {prefixe}_START_OFF, 1);")
+            w(f"    IOWR_32DIRECT(base, {prefixe}_START_OFF, 0);")
+            w("}")
+        if "STATUS" in controle:
+            w(f"static inline uint32_t {p}_status(uint32_t base)")
+            w("{")
+            w(f"    return IORD_32DIRECT(base, {prefixe}_STATUS_OFF);")
+            w("}")
+
+    w("")
+    w(f"#endif /* {garde} */")
+    texte = "\n".join(out) + "\n"
+
+    # Pas de réécriture si rien n'a changé : évite de tout recompiler
+    if os.path.exists(sortie):
+        with open(sortie, encoding="utf-8") as f:
+            if f.read() == texte:
+                return
+    with open(sortie, "w", encoding="utf-8") as f:
+        f.write(texte)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("entrees", nargs="+", help="répertoire .prj ou fichiers *_register_map.hpp")
+    ap.add_argument("--kernel", action="append", default=[], metavar="NOM=PREFIXE",
+                    help="ne garder que le kernel NOM (nom complet, jokers * ? admis), "
+                         "avec PREFIXE pour les macros")
+    ap.add_argument("--need", action="append", default=[], metavar="PREFIXE=ARG,...",
+                    help="arguments CSR que le pilote écrit : erreur s'il en manque")
+    ap.add_argument("-o", "--output", required=True)
+    opts = ap.parse_args()
+
+    fichiers = []
+    for e in opts.entrees:
+        if os.path.isdir(e):
+            fichiers += sorted(glob.glob(os.path.join(e, "include", "kernel_headers",
+                                                      "*_register_map.hpp")))
+        else:
+            fichiers.append(e)
+    if not fichiers:
+        raise SystemExit("aucun *_register_map.hpp trouvé (rapport compilé ?)")
+
+    choix = [k.split("=", 1) for k in opts.kernel]
+    if any(len(c) != 2 for c in choix):
+        raise SystemExit("--kernel attend NOM=PREFIXE")
+    besoins = [n.split("=", 1) for n in opts.need]
+    if any(len(b) != 2 for b in besoins):
+        raise SystemExit("--need attend PREFIXE=ARG,...")
+
+    kernels = []
+    for fichier in fichiers:
+        base = os.path.basename(fichier)[:-len("_register_map.hpp")]
+        if choix:
+            prefixes = [p for motif, p in choix if fnmatch.fnmatchcase(nom_kernel(base), motif)]
+            if not prefixes:
+                continue
+            prefixe = prefixes[0]
+        else:
+            prefixe = re.sub(r"\W", "_", base).upper()
+        kernels.append((prefixe, fichier, lire_carte(fichier)))
+
+    vus = [k[0] for k in kernels]
+    doublons = sorted({p for p in vus if vus.count(p) > 1})
+    if doublons:
+        raise SystemExit(f"préfixe attribué à plusieurs kernels : {', '.join(doublons)} "
+                         "(jokers --kernel trop larges ?)")
+    for motif, p in choix:
+        if not any(k[0] == p for k in kernels):
+            raise SystemExit(f"aucun kernel ne correspond à {motif}")
+    for p, liste in besoins:
+        carte = [k for k in kernels if k[0] == p]
+        if not carte:
+            raise SystemExit(f"--need : aucun kernel de préfixe {p}")
+        presents = {nom for nom, _, _ in carte[0][2][1]}
+        manquants = [a for a in liste.upper().split(",") if a and a not in presents]
+        if manquants:
+            raise SystemExit(f"{carte[0][1]} : {p} n'a pas d'argument CSR "
+                             f"{', '.join(manquants)} (conduit ?)")
+    generer(kernels, opts.output)
+    print(f"{opts.output} : " + ", ".join(k[0] for k in kernels), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
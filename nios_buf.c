@@ -0,0 +1,134 @@
+/******************************************************************************
+ *  Gestion des tampons partagés Nios II / IP — voir nios_buf.h
+ *
+ *  Deux arènes à allocation linéaire : la RAM on-chip et, si le système en
+ *  a une, la DDR EMIF. Pour un tampon caché, seule la zone sale est écrite
+ *  en mémoire avant l'IP, et seule la zone que le CPU va relire est
+ *  invalidée après : le coût suit les octets touchés, pas la trame.
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <system.h>        /* *_BASE / *_SPAN, NIOS2_DCACHE_LINE_SIZE */
+#include <sys/alt_cache.h> /* alt_dcache_flush*(), alt_remap_*()      */
+
+#include "nios_buf.h"
+
+#ifdef NIOS2_DCACHE_LINE_SIZE
+#define LINE NIOS2_DCACHE_LINE_SIZE
+#else
+#define LINE 32
+#endif
+
+/* ---------- Arènes -------------------------------------------------------- */
+typedef struct {
+    uintptr_t base;
+    uint32_t  span;
+    uint32_t  used;
+} arena_t;
+
+static arena_t arenas[2] = {
+    { INTEL_ONCHIP_MEMORY_1_BASE, INTEL_ONCHIP_MEMORY_1_SPAN, NBUF_ONCHIP_RESERVED },
+#ifdef EMIF_FM_0_ARCH_BASE
+    { EMIF_FM_0_ARCH_BASE, EMIF_FM_0_ARCH_SPAN, 0 },
+#else
+    { 0, 0, 0 },
+#endif
+};
+
+static nbuf_stats_t stats;
+
+static uint8_t *arena_take(nbuf_place_t place, uint32_t bytes)
+{
+    arena_t *a = &arenas[place];
+    const uint32_t debut = (a->used + LINE - 1) & ~(uint32_t)(LINE - 1);
+    if (a->span == 0 || debut > a->span || bytes > a->span - debut)
+        return NULL;
+    a->used = debut + bytes;
+    return (uint8_t *)(a->base + debut);
+}
+
+/* ---------- API ----------------------------------------------------------- */
+int nbuf_alloc(nbuf_t *b, uint32_t bytes, nbuf_place_t place, nbuf_mode_t mode)
+{
+    /* Tampon arrondi à la ligne : la fin ne partage rien non plus */
+    bytes = (bytes + LINE - 1) & ~(uint32_t)(LINE - 1);
+
+    uint8_t *p = NULL;
+    if (place == NBUF_AUTO) {
+        place = bytes <= NBUF_AUTO_ONCHIP_MAX ? NBUF_ONCHIP : NBUF_EMIF;
+        p = arena_take(place, bytes);
+        if (p == NULL) {                       /* repli sur l'autre région */
+            place = place == NBUF_ONCHIP ? NBUF_EMIF : NBUF_ONCHIP;
+            p = arena_take(place, bytes);
+        }
+    } else {
+        p = arena_take(place, bytes);
+    }
+    if (p == NULL)
+        return -1;
+
+    b->ip       = p;
+    b->bytes    = bytes;
+    b->place    = place;
+    b->mode     = mode;
+    b->dirty_lo = bytes;
+    b->dirty_hi = 0;
+
+    /* L'alias non caché vide d'abord les lignes de la zone ; ensuite le CPU
+     * ne passe plus jamais par le cache pour ce tampon                     */
+    b->cpu = mode == NBUF_UNCACHED ? (uint8_t *)alt_remap_uncached(p, bytes) : p;
+    return 0;
+}
+
+void nbuf_dirty(nbuf_t *b, uint32_t off, uint32_t len)
+{
+    if (b->mode == NBUF_UNCACHED || len == 0)
+        return;
+    if (off < b->dirty_lo)
+        b->dirty_lo = off;
+    if (off + len > b->dirty_hi)
+        b->dirty_hi = off + len > b->bytes ? b->bytes : off + len;
+}
+
+void nbuf_to_ip(nbuf_t *b)
+{
+    if (b->mode == NBUF_UNCACHED || b->dirty_hi <= b->dirty_lo)
+        return;
+
+    const uint32_t lo = b->dirty_lo & ~(uint32_t)(LINE - 1);
+    const uint32_t hi = (b->dirty_hi + LINE - 1) & ~(uint32_t)(LINE - 1);
+    alt_dcache_flush(b->cpu + lo, hi - lo);
+    stats.flushed += hi - lo;
+    stats.ops++;
+
+    b->dirty_lo = b->bytes;
+    b->dirty_hi = 0;
+}
+
+void nbuf_from_ip(nbuf_t *b, uint32_t off, uint32_t len)
+{
+    if (b->mode == NBUF_UNCACHED || len == 0)
+        return;
+
+    const uint32_t lo = off & ~(uint32_t)(LINE - 1);
+    uint32_t hi = (off + len + LINE - 1) & ~(uint32_t)(LINE - 1);
+    if (hi > b->bytes)
+        hi = b->bytes;
+    alt_dcache_flush_no_writeback(b->cpu + lo, hi - lo);
+    stats.invalidated += hi - lo;
+    stats.ops++;
+}
+
+uint32_t nbuf_free(nbuf_place_t place)
+{
+    if (place == NBUF_AUTO)
+        return nbuf_free(NBUF_ONCHIP) + nbuf_free(NBUF_EMIF);
+    const arena_t *a = &arenas[place];
+    return a->span > a->used ? a->span - a->used : 0;
+}
+
+void nbuf_stats(nbuf_stats_t *s)
+{
+    *s = stats;
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+ *  Gestion des tampons partagés Nios II / IP
+ *
+ *  – Placement : RAM on-chip ou DDR EMIF, au choix ou par politique (AUTO :
+ *    on-chip pour les petits tampons tant qu'il reste de la place)
+ *  – NBUF_UNCACHED : le CPU passe par l'alias non caché (alt_remap_uncached),
+ *    aucune maintenance de cache ; pour les tampons possédés par l'IP que le
+ *    CPU écrit ou lit une fois, en flux
+ *  – NBUF_CACHED : le CPU passe par le cache ; il déclare ce qu'il écrit
+ *    (nbuf_dirty) et ce qu'il va relire (nbuf_from_ip) : flush et
+ *    invalidation ne portent que sur ces octets, arrondis aux lignes
+ *
+ *  Les allocations sont alignées sur une ligne de cache, de sorte qu'aucune
+ *  ligne n'est partagée entre deux tampons ou avec d'autres données.
+ ******************************************************************************/
+
+#ifndef __NIOS_BUF_H__
+#define __NIOS_BUF_H__
+
+#include <stdint.h>
+
+/* ---------- Politique ----------------------------------------------------- */
+#ifndef NBUF_ONCHIP_RESERVED
+#define NBUF_ONCHIP_RESERVED 0          /* octets laissés en tête de l'on-chip */
+#endif
+#ifndef NBUF_AUTO_ONCHIP_MAX
+#define NBUF_AUTO_ONCHIP_MAX (16 * 1024) /* AUTO : au-delà, DDR EMIF          */
+#endif
+
+typedef enum {
+    NBUF_ONCHIP = 0,
+    NBUF_EMIF,
+    NBUF_AUTO
+} nbuf_place_t;
+
+typedef enum {
+    NBUF_CACHED = 0,
+    NBUF_UNCACHED
+} nbuf_mode_t;
+
+typedef struct {
+    uint8_t      *cpu;       /* pointeur pour le CPU (caché ou alias)      */
+    uint8_t      *ip;        /* adresse à passer à l'IP                    */
+    uint32_t      bytes;
+    nbuf_place_t  place;     /* NBUF_ONCHIP ou NBUF_EMIF après allocation  */
+    nbuf_mode_t   mode;
+    uint32_t      dirty_lo;  /* [dirty_lo, dirty_hi[ écrit par le CPU      */
+    uint32_t      dirty_hi;
+} nbuf_t;
+
+typedef struct {
+    uint32_t flushed;        /* octets écrits en mémoire (lignes entières)  */
+    uint32_t invalidated;    /* octets invalidés                            */
+    uint32_t ops;            /* appels au HAL de cache                      */
+} nbuf_stats_t;
+
+/* Alloue bytes octets selon place / mode ; 0 si réussi, -1 si plus de place.
+ * Pas de libération : les tampons vivent autant que l'application.        */
+int  nbuf_alloc(nbuf_t *b, uint32_t bytes, nbuf_place_t place, nbuf_mode_t mode);
+
+/* Le CPU a écrit [off, off + len[ (mode caché ; sans effet sinon) */
+void nbuf_dirty(nbuf_t *b, uint32_t off, uint32_t len);
+
+/* Avant de confier b à l'IP : écrit en mémoire la seule zone sale */
+void nbuf_to_ip(nbuf_t *b);
+
+/* Après l'IP, avant que le CPU relise [off, off + len[ : invalide cette
+ * zone sans write-back (l'IP en est propriétaire)                          */
+void nbuf_from_ip(nbuf_t *b, uint32_t off, uint32_t len);
+
+/* Octets encore libres dans chaque région */
+uint32_t nbuf_free(nbuf_place_t place);
+
+void nbuf_stats(nbuf_stats_t *s);
+
+#endif /* __NIOS_BUF_H__ */
@@ -1,44 +1,56 @@
 /******************************************************************************
  *  Transpose 32×32 — version compatible avec votre BSP / symboles
  *
- *  – Entrée  : EMIF_FM_0_ARCH_BASE  (SDRAM)
+ *  – Entrée  : EMIF_FM_0_ARCH_BASE si présente, sinon RAM on-chip
  *  – Sortie  : INTEL_ONCHIP_MEMORY_1_BASE (RAM on-chip)
- *  – IP CSR  : TRANSPOSETEST_REPORT_DI_0_BASE
+ *  – IP CSR  : TRANSPOSE_REPORT_DI_1_BASE (offsets : transpose_drv.h, ou
+ *              transpose_csr.h généré par gen_csr.py)
+ *  – Sur PC  : compile tel quel contre csr_sim/ (voir csr_sim/csr_sim.h)
+ *  – Pilote  : transpose_drv.c (IRQ done, soumission asynchrone)
+ *  – Tampons : nios_buf.c (entrées en DDR si présente, sorties non cachées)
  ******************************************************************************/
 
 #include <stdio.h>
 #include <stdint.h>
-#include <system.h>        /* symboles *_BASE                        */
-#include <io.h>            /* IOWR_32DIRECT / IORD_32DIRECT          */
-#include <sys/alt_cache.h> /* alt_dcache_flush(), alt_dcache_flush_all() */
+#include <system.h>        /* symboles *_BASE / *_IRQ                */
 
-/* ---------- Adresse CSR -------------------------------------------------- */
-#define CSR_BASE   TRANSPOSE_REPORT_DI_1_BASE
+#include "transpose_drv.h" /* pilote IRQ + file de requêtes          */
+#include "nios_buf.h"      /* placement + maintenance de cache       */
 
-/* ---------- Offsets (doc oneAPI) ---------------------------------------- */
-#define STATUS_OFF         0x00      /* R : bit 1 = DONE, bit 2 = BUSY  */
-#define START_OFF          0x08
-#define ARG_IN_LO_OFF      0x80
-#define ARG_OUT_LO_OFF     0x88
-#define ARG_ROWS_OFF       0x90
-#define ARG_COLS_OFF       0x94
-
-/* ---------- Masques ------------------------------------------------------ */
-#define DONE_MASK  0x2
-#define BUSY_MASK  0x4
-
-/* ---------- Helper : write 64-bit CSR argument -------------------------- */
-#define IOWR64(base, off, val64)                         \
-    do {                                                 \
-        IOWR_32DIRECT((base), (off),      (uint32_t)(val64));      \
-        IOWR_32DIRECT((base), (off) + 4U, (uint32_t)((val64) >> 32)); \
-    } while (0)
+/* ---------- Adresse CSR / IRQ ------------------------------------------- */
+#define CSR_BASE   TRANSPOSE_REPORT_DI_1_BASE
+#define CSR_IRQ    TRANSPOSE_REPORT_DI_1_IRQ
+#define CSR_IRQ_IC TRANSPOSE_REPORT_DI_1_IRQ_INTERRUPT_CONTROLLER_ID
+
+/* IP TransposeRing (anneau de descripteurs), si présente dans le système */
+#ifdef TRANSPOSE_RING_DI_0_BASE
+#define RING_CSR    TRANSPOSE_RING_DI_0_BASE
+#define RING_IRQ    TRANSPOSE_RING_DI_0_IRQ
+#define RING_IRQ_IC TRANSPOSE_RING_DI_0_IRQ_INTERRUPT_CONTROLLER_ID
+#define RING_SIZE   8
+#define RING_NBUF   4      /* trames en vol dans l'anneau            */
+#endif
 
 /* ---------- Dimensions du test ------------------------------------------ */
 #define ROWS   32
 #define COLS   32
 #define ELEMS  (ROWS * COLS)
 #define BYTES  (ELEMS * sizeof(uint32_t))
+#define FRAMES 10
+#define NBUF   2           /* double tampon entrée / sortie           */
+
+/* Entrées : écrites par le CPU à travers le cache, en DDR si le système en
+ * a une (test DDR). Sorties : lues une fois, par l'alias non caché.       */
+#ifndef IN_PLACE
+#ifdef EMIF_FM_0_ARCH_BASE
+#define IN_PLACE  NBUF_EMIF
+#else
+#define IN_PLACE  NBUF_ONCHIP
+#endif
+#endif
+#ifndef OUT_PLACE
+#define OUT_PLACE NBUF_ONCHIP
+#endif
 
 /* ---------- Dump rapide -------------------------------------------------- */
 static void dump_matrix(volatile uint32_t *m)
@@ -51,56 +63,148 @@ static void dump_matrix(volatile uint32_t *m)
     }
 }
 
-int main(void)
+/* ---------- Préparation / vérification d'une trame ---------------------- */
+static void fill_frame(nbuf_t *b, uint32_t frame)
 {
-    printf("Transpose %ux%u – test cohérence cache/DDR\n", ROWS, COLS);
-
-    /* 1) Buffers --------------------------------------------------------- */
-    volatile uint32_t *in_buf  = (uint32_t *)INTEL_ONCHIP_MEMORY_1_BASE;
-    volatile uint32_t *out_buf = (uint32_t *)(INTEL_ONCHIP_MEMORY_1_BASE + BYTES);
-
-    /* 2) Init entrée, clear sortie -------------------------------------- */
+    uint32_t *in = (uint32_t *)b->cpu;
     for (uint32_t r = 0; r < ROWS; ++r)
         for (uint32_t c = 0; c < COLS; ++c)
-            in_buf[r * COLS + c] = r * COLS + c;
+            in[r * COLS + c] = frame * ELEMS + r * COLS + c;
+    nbuf_dirty(b, 0, BYTES);
+    nbuf_to_ip(b);
+}
 
-    for (uint32_t i = 0; i < ELEMS; ++i)
-        out_buf[i] = 0;
+static uint32_t check_frame(nbuf_t *b, uint32_t frame)
+{
+    nbuf_from_ip(b, 0, BYTES);
+    volatile uint32_t *out = (volatile uint32_t *)b->cpu;
+    uint32_t errors = 0;
+    for (uint32_t c = 0; c < COLS; ++c)
+        for (uint32_t r = 0; r < ROWS; ++r)
+            errors += out[c * ROWS + r] != frame * ELEMS + r * COLS + c;
+    return errors;
+}
 
-    /* Flush les deux zones avant accès IP ------------------------------- */
-    alt_dcache_flush((void *)in_buf,  BYTES);
-    alt_dcache_flush((void *)out_buf, BYTES);
+#ifdef RING_CSR
+/* ---------- Mode anneau : FRAMES trames, un accès CSR par lot ----------- */
+static uint32_t ring_test(void)
+{
+    /* Descripteurs en on-chip, vus par le CPU à travers l'alias non caché :
+     * l'IP les relit et y écrit status sans passer par le cache du Nios   */
+    static nbuf_t ring_buf;
+    static transpose_ring_t ring;
+    if (nbuf_alloc(&ring_buf, RING_SIZE * sizeof(transpose_desc_t), NBUF_ONCHIP,
+                   NBUF_UNCACHED) != 0) {
+        puts("Plus de place on-chip pour l'anneau");
+        return 1;
+    }
+    if (transpose_ring_init(&ring, RING_CSR, RING_IRQ_IC, RING_IRQ,
+                            (transpose_desc_t *)ring_buf.cpu, ring_buf.ip, RING_SIZE)
+        != TRANSPOSE_OK) {
+        puts("Init anneau impossible");
+        return 1;
+    }
 
-    /* 3) Paramétrer la CSR ---------------------------------------------- */
-    IOWR64(CSR_BASE, ARG_IN_LO_OFF,  (uint64_t)in_buf);
-    IOWR64(CSR_BASE, ARG_OUT_LO_OFF, (uint64_t)out_buf);
-    IOWR_32DIRECT(CSR_BASE, ARG_ROWS_OFF, ROWS);
-    IOWR_32DIRECT(CSR_BASE, ARG_COLS_OFF, COLS);
+    /* Tampons propres à l'anneau : RING_NBUF trames en vol au lieu de 2 */
+    static nbuf_t in_buf[RING_NBUF], out_buf[RING_NBUF];
+    for (int b = 0; b < RING_NBUF; ++b)
+        if (nbuf_alloc(&in_buf[b], BYTES, IN_PLACE, NBUF_CACHED) != 0 ||
+            nbuf_alloc(&out_buf[b], BYTES, OUT_PLACE, NBUF_UNCACHED) != 0) {
+            puts("Plus de place pour les tampons de l'anneau");
+            return 1;
+        }
+
+    /* Le CPU remplit tous les tampons libres puis les ajoute d'affilée
+     * avant de récupérer : les trames ajoutées pendant un lot partent
+     * ensemble au lot suivant, sans accès CSR entre deux trames          */
+    uint32_t errors = 0, filled = 0, pushed = 0, reaped = 0;
+    while (reaped < FRAMES) {
+        for (; filled < FRAMES && filled - reaped < RING_NBUF; filled++)
+            fill_frame(&in_buf[filled % RING_NBUF], filled);
+        for (; pushed < filled; pushed++)
+            transpose_ring_push(&ring, in_buf[pushed % RING_NBUF].ip,
+                                out_buf[pushed % RING_NBUF].ip, ROWS, COLS);
+        while (transpose_ring_reap(&ring) != NULL) {
+            errors += check_frame(&out_buf[reaped % RING_NBUF], reaped);
+            reaped++;
+        }
+    }
 
-    /* 4) Boucle de tests ------------------------------------------------- */
-    for (int it = 0; it < 10; ++it) {
+    printf("Anneau : %u trames en %u lots, %u erreurs\n", FRAMES,
+           (unsigned)ring.nb_lots, (unsigned)errors);
+    return errors;
+}
+#endif
 
-        /* a) S’assurer que l’IP est idle -------------------------------- */
-        while (IORD_32DIRECT(CSR_BASE, STATUS_OFF) & BUSY_MASK)
-            ;
+int main(void)
+{
+    printf("Transpose %ux%u – %u trames, pilote IRQ\n", ROWS, COLS, FRAMES);
+
+    /* 1) Buffers : NBUF entrées puis NBUF sorties ----------------------- */
+    static nbuf_t in_buf[NBUF], out_buf[NBUF];
+    for (int b = 0; b < NBUF; ++b) {
+        if (nbuf_alloc(&in_buf[b], BYTES, IN_PLACE, NBUF_CACHED) != 0 ||
+            nbuf_alloc(&out_buf[b], BYTES, OUT_PLACE, NBUF_UNCACHED) != 0) {
+            puts("Plus de place pour les tampons");
+            return 1;
+        }
+        volatile uint32_t *out = (volatile uint32_t *)out_buf[b].cpu;
+        for (uint32_t i = 0; i < ELEMS; ++i)
+            out[i] = 0;
+    }
+    printf("Entrées en %s, sorties en %s\n",
+           in_buf[0].place == NBUF_EMIF ? "DDR EMIF" : "on-chip",
+           out_buf[0].place == NBUF_EMIF ? "DDR EMIF" : "on-chip");
+
+    /* 2) Pilote ---------------------------------------------------------- */
+    static transpose_dev_t dev;
+    if (transpose_init(&dev, CSR_BASE, CSR_IRQ_IC, CSR_IRQ) != TRANSPOSE_OK) {
+        puts("Init pilote impossible");
+        return 1;
+    }
 
-        /* b) Start : flanc montant -------------------------------------- */
-        IOWR_32DIRECT(CSR_BASE, START_OFF, 1);
-        IOWR_32DIRECT(CSR_BASE, START_OFF, 0);
+    transpose_req_t req[NBUF];
+    for (int b = 0; b < NBUF; ++b) {
+        /* out_bytes = 0 : la maintenance de cache est faite par nios_buf */
+        req[b] = (transpose_req_t){ .in = in_buf[b].ip, .out = out_buf[b].ip,
+                                    .rows = ROWS, .cols = COLS, .out_bytes = 0 };
+    }
 
-        /* c) Attendre DONE && !BUSY ------------------------------------- */
-        uint32_t st;
-        do {
-            st = IORD_32DIRECT(CSR_BASE, STATUS_OFF);
-        } while ((st & DONE_MASK) == 0 || (st & BUSY_MASK));
+    /* 3) Pipeline : l'IP transpose la trame k pendant que le CPU prépare
+     *    la trame k + 1 puis vérifie la trame k - 1 ------------------------ */
+    uint32_t errors = 0;
+    fill_frame(&in_buf[0], 0);
+    transpose_submit(&dev, &req[0]);
 
-        /* d) Invalidate avant lecture ----------------------------------- */
-        alt_dcache_flush((void *)out_buf, BYTES);   /* ou alt_dcache_flush_all() */
+    for (uint32_t k = 0; k < FRAMES; ++k) {
+        const int b = k % NBUF, nb = (k + 1) % NBUF;
 
-        /* e) Afficher ---------------------------------------------------- */
-        dump_matrix(out_buf);
+        if (k + 1 < FRAMES) {
+            transpose_wait(&dev, &req[nb]);   /* tampon nb libre (trame k - 1) */
+            fill_frame(&in_buf[nb], k + 1);
+            transpose_submit(&dev, &req[nb]);
+        }
+
+        transpose_wait(&dev, &req[b]);
+        errors += check_frame(&out_buf[b], k);
     }
 
-    return 0;
-}
+    dump_matrix((volatile uint32_t *)out_buf[(FRAMES - 1) % NBUF].cpu);
+    printf("\n%u trames, %u IRQ, %u erreurs : %s\n", (unsigned)dev.nb_done,
+           (unsigned)dev.nb_irq, (unsigned)errors, errors == 0 ? "PASSED" : "FAILED");
+
+    transpose_shutdown(&dev);
 
+    /* Maintenance de cache : la seule zone écrite par le CPU, une fois par
+     * trame ; rien pour les sorties, lues par l'alias non caché          */
+    nbuf_stats_t st;
+    nbuf_stats(&st);
+    printf("Cache : %u octets écrits, %u invalidés, %u appels\n",
+           (unsigned)st.flushed, (unsigned)st.invalidated, (unsigned)st.ops);
+
+#ifdef RING_CSR
+    errors += ring_test();
+    puts(errors == 0 ? "PASSED" : "FAILED");
+#endif
+    return errors != 0;
+}
@@ -0,0 +1,129 @@
+#ifndef __PERF_COUNTERS_HPP__
+#define __PERF_COUNTERS_HPP__
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <type_traits>
+
+// -----------------------------------------------------------------------------
+// Compteurs de performance dans les kernels (optionnels)
+//
+// Activation à la compilation : -DPERF_COUNTERS=1. Sans cela les kernels
+// reçoivent NoPerf et n'ont aucun matériel en plus.
+//
+// Un kernel ne voit pas ses propres stalls : quand un LSU ou un pipe bloque,
+// toute la boucle est gelée, compteurs compris. Le temps est donc mesuré par
+// un kernel à part, PerfTimer, qui tourne à II=1 sans aucun accès bloquant
+// et compte les cycles entre le jeton de début et le jeton de fin que le
+// kernel mesuré lui envoie par un pipe de contrôle. Le kernel mesuré fournit
+// dans le jeton de fin :
+//   busy       : itérations utiles de ses boucles principales
+//   pipeStalls : itérations perdues sur un pipe vide (lectures non bloquantes)
+//   tiles      : unités de travail terminées (tuiles, bandes, battements)
+// Les cycles restants, cycles - busy - pipeStalls, sont ceux où la boucle
+// était gelée : côté mémoire, c'est l'attente des LSU (store pour les kernels
+// alimentés par pipe, load et store pour Transpose), à la latence de
+// remplissage des pipelines près.
+//
+// Le pipe de contrôle est de profondeur 0 : le kernel mesuré ne démarre que
+// quand PerfTimer a pris le jeton de début. Lancer PerfTimer avant lui.
+// -----------------------------------------------------------------------------
+
+#ifndef PERF_COUNTERS
+#define PERF_COUNTERS 0
+#endif
+
+namespace fpga_tools {
+
+// Jeton kernel -> PerfTimer
+struct PerfMsg {
+  uint64_t busy;
+  uint64_t pipeStalls;
+  uint64_t tiles;
+};
+
+// Résultat, écrit en USM par PerfTimer (une entrée par lancement mesuré)
+struct PerfCounters {
+  uint64_t cycles;     // du jeton de début au jeton de fin
+  uint64_t busy;
+  uint64_t pipeStalls;
+  uint64_t lsuStalls;  // cycles - busy - pipeStalls
+  uint64_t tiles;
+};
+
+// ---------- Sonde côté kernel -------------------------------------------------
+struct NoPerf {
+  static constexpr bool kOn = false;
+  static void start() {}
+  static void stop(uint64_t, uint64_t, uint64_t) {}
+};
+
+template <typename CtlPipe>
+struct PerfProbe {
+  static constexpr bool kOn = true;
+  static void start() { CtlPipe::write(PerfMsg{0, 0, 0}); }
+  // Les écritures en mémoire du kernel sont terminées avant le jeton de fin
+  static void stop(uint64_t busy, uint64_t pipeStalls, uint64_t tiles) {
+    sycl::atomic_fence(sycl::memory_order::seq_cst, sycl::memory_scope::device);
+    CtlPipe::write(PerfMsg{busy, pipeStalls, tiles});
+  }
+};
+
+template <typename Id>
+using PerfPipe = sycl::ext::intel::experimental::pipe<Id, PerfMsg, 0>;
+
+// Sonde retenue selon PERF_COUNTERS
+template <typename Id>
+using PerfSel = std::conditional_t<bool(PERF_COUNTERS), PerfProbe<PerfPipe<Id>>, NoPerf>;
+
+// ---------- Compteur de cycles ------------------------------------------------
+// Mesure count lancements successifs du kernel relié à PerfPipe<Id>
+template <typename Id>
+struct PerfTimer {
+  PerfCounters* res;
+  uint32_t count{1};
+
+  void operator()() const {
+    for (uint32_t k = 0; k < count; k++) {
+      PerfMsg m = PerfPipe<Id>::read(); // début
+
+      uint64_t cycles = 0;
+      bool fin = false;
+      [[intel::initiation_interval(1)]]
+      while (!fin) {
+        m = PerfPipe<Id>::read(fin);
+        cycles++;
+      }
+
+      const uint64_t actifs = m.busy + m.pipeStalls;
+      res[k] = PerfCounters{cycles, m.busy, m.pipeStalls,
+                            cycles > actifs ? cycles - actifs : 0, m.tiles};
+    }
+  }
+};
+
+// ---------- Côté hôte ---------------------------------------------------------
+// samples : échantillons traités, bytes : octets échangés avec la mémoire
+inline void printPerf(std::ostream& os, const char* nom, const PerfCounters& c,
+                      uint64_t samples, uint64_t bytes, double fmaxMHz) {
+  const double cycles = c.cycles ? double(c.cycles) : 1.0;
+  const double pct = 100.0 / cycles;
+  const std::ios::fmtflags flags = os.flags();
+  const std::streamsize prec = os.precision();
+  os << nom << " : " << c.cycles << " cycles, " << c.tiles << " tuiles @ " << fmaxMHz
+     << " MHz\n" << std::fixed << std::setprecision(3)
+     << "  " << double(samples) / cycles << " échantillons/cycle, "
+     << double(bytes) * fmaxMHz * 1e6 / cycles / 1e9 << " GB/s\n"
+     << std::setprecision(1)
+     << "  utile " << double(c.busy) * pct << " %, attente pipe "
+     << double(c.pipeStalls) * pct << " %, attente LSU " << double(c.lsuStalls) * pct
+     << " %\n";
+  os.flags(flags);
+  os.precision(prec);
+}
+
+} // namespace fpga_tools
+
+#endif //__PERF_COUNTERS_HPP__
@@ -0,0 +1,39 @@
+#ifndef __PIPE_FEEDER_HPP__
+#define __PIPE_FEEDER_HPP__
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include <cstdint>
+
+namespace fpga_tools {
+
+// -----------------------------------------------------------------------------
+// Kernel d'alimentation d'un pipe depuis la mémoire (USM hôte ou device)
+// Remplace les boucles de Pipe::write(q, x) côté hôte : la trame entière est
+// préparée en mémoire puis poussée dans le pipe par ce kernel, lancé en même
+// temps que le kernel consommateur. Le débit n'est plus limité que par le
+// lien / la mémoire, et la profondeur du pipe ne borne plus la trame.
+// -----------------------------------------------------------------------------
+using PrefetchLSU = sycl::ext::intel::lsu<
+    sycl::ext::intel::prefetch<true>,            // lecture séquentielle
+    sycl::ext::intel::statically_coalesce<false>>;
+
+template <typename Pipe, typename Beat>
+struct PipeFeeder {
+  Beat* src; // n battements consécutifs
+  sycl::ext::oneapi::experimental::annotated_arg<
+      uint64_t, decltype(sycl::ext::oneapi::experimental::properties{
+                    sycl::ext::intel::experimental::conduit})>
+      n;
+
+  void operator()() const {
+    [[intel::initiation_interval(1)]]
+    for (uint64_t i = 0; i < n; i++)
+      Pipe::write(PrefetchLSU::load(
+          sycl::address_space_cast<sycl::access::address_space::global_space,
+                                   sycl::access::decorated::no>(src + i)));
+  }
+};
+
+} // namespace fpga_tools
+
+#endif //__PIPE_FEEDER_HPP__
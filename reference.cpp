@@ -1,56 +1,32 @@
 #include <cstddef>
 #include <cstdint>
 #include <complex>
+#include <chrono>
+#include <cstdlib>
 #include <vector>
 #include <iostream>
 #include <iomanip>
 
-/// Complexe à parties réelles et imaginaires sur 16 bits
-struct Complex16 {
-    int16_t real;
-    int16_t imag;
-};
+#include "reference_cpu.hpp"
 
-/// Alias pour un complexe en simple précision
-using ComplexF = std::complex<float>;
+// Validation et mesure de invertConjNorm2 (reference_cpu.hpp) : lot SIMD
+// multithread contre la boucle scalaire, puis mode rapide rcp + Newton.
+// Compiler avec -O3 -mavx2 (ou -mavx512f -mavx512bw / -march=native) -pthread.
+// Usage : ./reference [N] [nbThreads]   (défaut 2^24, tous les coeurs)
 
+using fpga_tools::cpu::Complex16;
+using fpga_tools::cpu::ComplexF;
+using fpga_tools::cpu::Recip;
 
 void generNb(std::vector<Complex16>& src, size_t N){
     for (std::size_t i = 0; i < N; ++i) {
-        float real_val = static_cast<float>(i + 1);
-        float imag_val = real_val + 0.5f;
-
-        // Attention : Complex16 stocke des entiers 16 bits.
-        src[i].real = static_cast<int16_t>(real_val);
-        src[i].imag = static_cast<int16_t>(imag_val);
-    }
-}
-
-/**
- * Pour i = 0..N-1 :
- *   dst[i] = conj(src[i]) / |src[i]|^2
- * où conj(a + jb) = a - jb et |a + jb|^2 = a² + b².
- * Si src[i] == 0, on met dst[i] = 0 pour éviter la division par zéro.
- */
-void invertConjNorm2(const Complex16* src, ComplexF* dst, std::size_t N) {
-    for (std::size_t i = 0; i < N; ++i) {
-        float a = static_cast<float>(src[i].real);
-        float b = static_cast<float>(src[i].imag);
-        float norm2 = a*a + b*b;
-
-        dst[i] = { a / norm2, -b / norm2 };
-        
-    }
-}
-
-void invertConjNorm2(const Complex16* src, ComplexF* dst, std::size_t N) {
-    for (std::size_t i = 0; i < N; ++i) {
-        float a = static_cast<float>(src[i].real);
-        float b = static_cast<float>(src[i].imag);
-        float norm2 = a*a + b*b;
-
-        dst[i] = { a / norm2, -b / norm2 };
-        
+        // Complex16 stocke des entiers 16 bits : au-delà de 32767 la valeur
+        // reboucle explicitement (modulo 2^16) au lieu d'une conversion
+        // float -> int16_t hors plage, non définie. La partie imaginaire
+        // (ancien i + 1.5 tronqué) vaut la partie réelle.
+        const int16_t v = static_cast<int16_t>(static_cast<uint16_t>(i + 1));
+        src[i].real = v;
+        src[i].imag = v;
     }
 }
 
@@ -74,32 +50,62 @@ void affichage(const Complex16* src, const ComplexF* dst, size_t N) {
             << "dst[" << i << "] = ("
             << dst[i].real() << ", " << dst[i].imag() << "j)\n";
     }
+    std::cout << std::defaultfloat;
 }
 
-int main() {
-    size_t N = 8 ;
+// Meilleur temps (s) sur quelques répétitions
+template <typename F>
+double mesure(F&& f, int nbRep) {
+    double best = 1e30;
+    for (int k = 0; k < nbRep; ++k) {
+        auto d0 = std::chrono::steady_clock::now();
+        f();
+        auto d1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(d1 - d0).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    const size_t N = argc > 1 ? size_t(std::atoll(argv[1])) : size_t(1) << 24;
+    const unsigned nbThreads = argc > 2 ? unsigned(std::atoi(argv[2])) : 0;
 
-    std::cout << "Nombre d'élements : " << N << "\n" ; 
-    
+    std::cout << "Nombre d'élements : " << N << "\n" ;
 
     // Allocation des tableaux source et destination
     std::vector<Complex16> src(N);
-    std::vector<ComplexF> dst(N);
+    std::vector<ComplexF> ref(N), dst(N), rapide(N);
 
-    // Génération des nombres complexes :
-    
+    // Génération des nombres complexes (le compteur i + 1 reboucle sur 16
+    // bits et passe par 0, -32768, ...)
     generNb(src,N);
-    
 
-    // Calcul
-    invertConjNorm2(src.data(), dst.data(), N);    
+    // Calcul : boucle scalaire, lot SIMD multithread, mode rapide
+    const double sScal = mesure([&] {
+        for (size_t i = 0; i < N; ++i)
+            ref[i] = fpga_tools::cpu::invertConjNorm2(src[i]); }, 3);
+    const double sLot = mesure([&] {
+        fpga_tools::cpu::invertConjNorm2(src.data(), dst.data(), N, nbThreads); }, 3);
+    const double sRap = mesure([&] {
+        fpga_tools::cpu::invertConjNorm2<Recip::Rapide>(src.data(), rapide.data(), N, nbThreads); }, 3);
+
+    affichage(src.data(), dst.data(), std::min<size_t>(N, 8));
 
-    affichage(src.data(), dst.data(), N);
+    // Le lot exact doit être identique bit à bit à la boucle scalaire
+    const int ok = verif<ComplexF>(dst.data(), ref.data(), N);
 
-    int ok = verif<ComplexF>(dst.data(), dst.data(), N);
+    // Écart relatif max du mode rapide
+    float ecart = 0.0f;
+    for (size_t i = 0; i < N; ++i)
+        if (ref[i] != ComplexF(0.0f, 0.0f))
+            ecart = std::max(ecart, std::abs(rapide[i] - ref[i]) / std::abs(ref[i]));
 
-    std::cout << "\nVérification dst vs dst : "
+    std::cout << "\nVérification lot vs scalaire : "
               << (ok ? "identiques\n" : "différents\n");
+    std::cout << "Écart relatif max du mode rapide : " << ecart << '\n';
+    std::cout << "scalaire " << N / sScal / 1e6 << " Méch/s, lot "
+              << N / sLot / 1e6 << " Méch/s, rapide " << N / sRap / 1e6 << " Méch/s\n";
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
 
-    return 0;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
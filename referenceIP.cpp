@@ -5,14 +5,41 @@
 #include <sycl/ext/intel/ac_types/ac_fixed.hpp>
 #include <sycl/ext/intel/ac_types/ac_fixed_math.hpp>
 #include <sycl/ext/intel/ac_types/ap_float_math.hpp>
+#include "perf_counters.hpp"
+#include "pipe_feeder.hpp"
+#include "reference_cpu.hpp"
 
 class ReferenceKernel;
+class ReferenceStreamKernel;
+class FeederKernel;
+class FeederStreamKernel;
+class SinkKernel;
 class IDInputPipe ; 
+class IDInputPipeS;
+class IDOutputPipe;
+class PerfTimerKernel;
+class PerfIdRef;
 
 constexpr int SHIFT = 14;
 
 constexpr int Kbl2 = 2;
 
+// Nombre d'échantillons traités par cycle : 16 × 32 bits = un store 512 bits
+constexpr int kLanes = 16;
+
+// Horloge du kernel pour les compteurs (-DPERF_COUNTERS=1)
+constexpr double kFmaxMHz = 300.0;
+using RefPerf = fpga_tools::PerfSel<PerfIdRef>;
+
+// Chemin de calcul de conj(x) / |x|^2 :
+//   1 : virgule fixe pure (LUT + Newton-Raphson), sans opérateur flottant
+//   0 : chemin flottant d'origine (division float)
+// Sélection à la compilation : -DRECIP_FIXED_POINT=0. Le modèle hôte
+// (reference_cpu.hpp) suit le même choix.
+#ifndef RECIP_FIXED_POINT
+#define RECIP_FIXED_POINT 1
+#endif
+
 using fixed_s14 = ac_fixed<16, 2, true, AC_RND_CONV, AC_SAT>;
 
 using pipe_props = decltype(
@@ -22,29 +49,50 @@ using pipe_props = decltype(
 using out_props = decltype(
     sycl::ext::oneapi::experimental::properties{
     sycl::ext::intel::experimental::buffer_location<Kbl2>,
-    sycl::ext::intel::experimental::dwidth<32>, //512
-    sycl::ext::intel::experimental::awidth<13>, //512
+    sycl::ext::intel::experimental::dwidth<32 * kLanes>, // kLanes résultats par store
+    // adresses 64 bits : N n'est plus borné par la fenêtre d'adresses
+    sycl::ext::intel::experimental::awidth<64>,
     sycl::ext::intel::experimental::latency<0>,
     sycl::ext::intel::experimental::read_write_mode_write,
-    // un Complex fait 2×32 bits = 64 bits = 8 octets d'alignement
-    sycl::ext::oneapi::experimental::alignment<4>}); //64
+    // un ComplexF fait 2×16 bits = 4 octets, kLanes par battement
+    sycl::ext::oneapi::experimental::alignment<4 * kLanes>});
 
 using Complex = ac_complex<int16_t>;
 using ComplexF = ac_complex<fixed_s14>;
 using accum_t = ac_fixed<32, 2, true>;
 using f32ap = ihc::ap_float<8,23>;
+
+// Un battement du pipe : kLanes échantillons consécutifs
+struct InBeat {
+    Complex v[kLanes];
+};
+
+// kLanes résultats, pour la variante à sortie pipe
+struct OutBeat {
+    ComplexF v[kLanes];
+};
+
 using InputPipe = sycl::ext::intel::experimental::pipe<
-    IDInputPipe, Complex, 0, pipe_props>;
+    IDInputPipe, InBeat, 0, pipe_props>;
+using Feeder = fpga_tools::PipeFeeder<InputPipe, InBeat>;
+
+// Chaîne de test de la variante pipe -> pipe
+using InputPipeS = sycl::ext::intel::experimental::pipe<
+    IDInputPipeS, InBeat, 0, pipe_props>;
+using OutputPipe = sycl::ext::intel::experimental::pipe<
+    IDOutputPipe, OutBeat, 0, pipe_props>;
+using FeederS = fpga_tools::PipeFeeder<InputPipeS, InBeat>;
 
 using LSUStore = sycl::ext::intel::lsu<
   sycl::ext::intel::burst_coalesce<false>,      // agrégation en bursts
   sycl::ext::intel::statically_coalesce<true>>;// on garde l’analyse simple
 
+// Variante mémoire : résultats écrits dans dst, N échantillons
 struct Reference {
     sycl::ext::oneapi::experimental::annotated_arg<
         ComplexF*,out_props> dst; 
 
-    sycl::ext::oneapi::experimental::annotated_arg<uint16_t,
+    sycl::ext::oneapi::experimental::annotated_arg<uint64_t,
         decltype(sycl::ext::oneapi::experimental::properties{
         sycl::ext::intel::experimental::conduit})>  N;
 
@@ -54,42 +102,192 @@ struct Reference {
       }; 
     }    
     
-    [[intel::kernel_args_restrict]]
-    void operator()() const {
-        
-        for (uint16_t i = 0; i < N; i++) {
-            const Complex input = InputPipe::read() ;
+#if RECIP_FIXED_POINT
+    // round(v * y / 2^s) à la demi-unité loin de zéro, y en u2.30 (pas de
+    // dépassement : |v| * y < 2^17 * 2^31)
+    static ac_int<16, true> scaleRound(const ac_int<17, true>& v,
+                                       const ac_int<32, false>& y, int s) {
+        const bool neg = v < 0;
+        const ac_int<17, false> m = neg ? ac_int<17, false>(-v) : ac_int<17, false>(v);
+        ac_int<49, false> q = m * y;
+        q = (q + (ac_int<49, false>(1) << (s - 1))) >> s;
+        const ac_int<16, true> r = q;
+        return neg ? ac_int<16, true>(-r) : r;
+    }
+
+    // conj(x) / |x|^2 pour un échantillon, arrondi en s1.14, tout en entier :
+    //   |x|^2 = m · 2^p avec m dans [1, 2), 1/m amorcé par la LUT (≈ 2^-7)
+    //   puis deux itérations de Newton y <- y (2 - m y)  (≈ 2^-28)
+    //   résultat = v · y / 2^(p + 30 - SHIFT), v = re ou -im
+    // Même arrondi que le chemin flottant ; |x| = 0 donne 0.
+    static ComplexF invertConjNorm2(const Complex& input) {
+        const ac_int<16, true> re = input.real();
+        const ac_int<16, true> im = input.imag();
+
+        // |x|^2 <= 2^31 : exact sur 32 bits non signés
+        const ac_int<32, false> norm2 = re * re + im * im;
+
+        // Position du bit de tête (recherche de priorité déroulée)
+        int p = 0;
+        #pragma unroll
+        for (int k = 0; k < 32; k++)
+            if (norm2[k]) p = k;
+
+        // m en u1.31
+        const ac_int<32, false> m = norm2 << (31 - p);
 
-            float re_f = static_cast<float>(input.real());
-            float im_f = static_cast<float>(input.imag());
+        // 1/m en u2.30, table partagée avec le modèle hôte
+        constexpr int kLutBits = fpga_tools::cpu::kLutBits;
+        ac_int<32, false> y = ac_int<32, false>(
+            fpga_tools::cpu::kRecipLut.v[m.slc<kLutBits>(31 - kLutBits).to_uint()]) << 14;
 
-            const float norm2 = re_f * re_f + im_f * im_f;
-            const float norm2_inv = 1.0 / norm2 ;
+        #pragma unroll
+        for (int it = 0; it < 2; it++) {
+            const ac_int<32, false> t = (m * y) >> 31;              // m·y, u2.30
+            const ac_int<32, false> d = ac_int<32, false>(1u << 31) - t; // 2 - m·y
+            y = (y * d) >> 30;
+        }
+        // m = 1 (|x|^2 puissance de 2) : 1/m exact, sinon Newton s'arrête
+        // juste sous 2^30 et les demi-unités exactes partent vers zéro
+        if (m == ac_int<32, false>(1u << 31))
+            y = ac_int<32, false>(1u << 30);
+
+        const int s = 30 - SHIFT + p;
+        ac_int<16, true> bits_a = scaleRound(re, y, s);
+        ac_int<16, true> bits_b = scaleRound(-im, y, s);
+        if (norm2 == 0) {
+            bits_a = 0;
+            bits_b = 0;
+        }
+
+        fixed_s14 a; a.set_slc(0, bits_a);
+        fixed_s14 b; b.set_slc(0, bits_b);
+        return ComplexF{a, b};
+    }
+#else
+    // conj(x) / |x|^2 pour un échantillon, arrondi en s1.14
+    static ComplexF invertConjNorm2(const Complex& input) {
+        float re_f = static_cast<float>(input.real());
+        float im_f = static_cast<float>(input.imag());
+
+        const float norm2 = re_f * re_f + im_f * im_f;
+        const float norm2_inv = 1.0f / norm2 ;
+
+        const float out_re_f =  re_f * norm2_inv;   
+        const float out_im_f = -im_f * norm2_inv;   
+
+        const float scaled_re = out_re_f * (1 << SHIFT);
+        const float round_offset_re = (scaled_re >= 0.0f ? 0.5f : -0.5f);
+        int16_t raw_a = static_cast<int16_t>(scaled_re + round_offset_re);
 
-            const float out_re_f =  re_f * norm2_inv;   
-            const float out_im_f = -im_f * norm2_inv;   
+        float scaled_im = out_im_f * (1 << SHIFT);
+        float round_offset_im = (scaled_im >= 0.0f ? 0.5f : -0.5f);
+        int16_t raw_b = static_cast<int16_t>(scaled_im + round_offset_im);
 
-            const float scaled_re = out_re_f * (1 << SHIFT);
-            const float round_offset_re = (scaled_re >= 0.0f ? 0.5f : -0.5f);
-            int16_t raw_a = static_cast<int16_t>(scaled_re + round_offset_re);
+        // |x| = 0 : 0 comme le chemin virgule fixe
+        if (norm2 == 0.0f) {
+            raw_a = 0;
+            raw_b = 0;
+        }
+
+        ac_int<16, true> bits_a = raw_a;
+        fixed_s14 a; a.set_slc(0, bits_a);
 
-            float scaled_im = out_im_f * (1 << SHIFT);
-            float round_offset_im = (scaled_im >= 0.0f ? 0.5f : -0.5f);
-            int16_t raw_b = static_cast<int16_t>(scaled_im + round_offset_im);
+        ac_int<16, true> bits_b = raw_b;
+        fixed_s14 b; b.set_slc(0, bits_b);
+
+        return ComplexF{a, b};
+    }
+#endif
 
-            ac_int<16, true> bits_a = raw_a;
-            fixed_s14 a; a.set_slc(0, bits_a);
+    // Battement i : kLanes résultats en un store large ; les voies au-delà
+    // de N (dernier battement partiel) ne sont pas écrites
+    void storeBeat(uint64_t i, const InBeat& input) const {
+        #pragma unroll
+        for (int l = 0; l < kLanes; l++) {
+            if (i * kLanes + l < N)
+                LSUStore::store( sycl::address_space_cast<
+                  sycl::access::address_space::global_space,
+                  sycl::access::decorated::no>(&dst[i * kLanes + l]),
+                  invertConjNorm2(input.v[l]));
+        }
+    }
 
-            ac_int<16, true> bits_b = raw_b;
-            fixed_s14 b; b.set_slc(0, bits_b);
+    // Une lecture de pipe et un store large de kLanes résultats par
+    // itération. N quelconque : le producteur envoie ceil(N / kLanes)
+    // battements, le dernier complété par des voies ignorées.
+    [[intel::kernel_args_restrict]]
+    void operator()() const {
+        const uint64_t nbBeats = (N + kLanes - 1) / kLanes;
 
-            LSUStore::store( sycl::address_space_cast<
-              sycl::access::address_space::global_space,
-              sycl::access::decorated::no>(&dst[i]),ComplexF{a,b});
+        if constexpr (RefPerf::kOn) {
+            // Lecture non bloquante : les itérations sur pipe vide sont
+            // comptées, le reste des cycles est l'attente du store
+            RefPerf::start();
+            uint64_t i = 0, attente = 0;
+            [[intel::initiation_interval(1)]]
+            while (i < nbBeats) {
+                bool ok = false;
+                const InBeat input = InputPipe::read(ok);
+                if (ok) {
+                    storeBeat(i, input);
+                    i++;
+                } else {
+                    attente++;
+                }
+            }
+            RefPerf::stop(nbBeats, attente, nbBeats);
+        } else {
+            for (uint64_t i = 0; i < nbBeats; i++)
+                storeBeat(i, InputPipe::read());
         }
     }
 };
 
+// Variante flux : InPipe -> OutPipe, sans aller-retour en mémoire, pour
+// chaîner directement un kernel aval (formation de voies, ...).
+// N = 0 : flux sans fin (le kernel ne rend jamais la main). Sinon
+// ceil(N / kLanes) battements en entrée comme en sortie ; les voies au-delà
+// de N du dernier battement sont ignorées et sortent à 0.
+template <typename InPipe, typename OutPipe>
+struct ReferenceStream {
+    sycl::ext::oneapi::experimental::annotated_arg<uint64_t,
+        decltype(sycl::ext::oneapi::experimental::properties{
+        sycl::ext::intel::experimental::conduit})>  N;
+
+    auto get(sycl::ext::oneapi::experimental::properties_tag) {
+      return sycl::ext::oneapi::experimental::properties {
+      sycl::ext::intel::experimental::streaming_interface<>
+      };
+    }
+
+    void operator()() const {
+        const uint64_t nbBeats = (N + kLanes - 1) / kLanes;
+        [[intel::initiation_interval(1)]]
+        for (uint64_t i = 0; N == 0 || i < nbBeats; i++) {
+            const InBeat input = InPipe::read();
+            OutBeat out;
+            #pragma unroll
+            for (int l = 0; l < kLanes; l++)
+                out.v[l] = (N == 0 || i * kLanes + l < N)
+                               ? Reference::invertConjNorm2(input.v[l])
+                               : ComplexF(fixed_s14(0), fixed_s14(0));
+            OutPipe::write(out);
+        }
+    }
+};
+
+// Kernel aval de test : recopie n battements du pipe en mémoire
+struct Sink {
+    OutBeat* dst;
+    uint64_t n;
+
+    void operator()() const {
+        for (uint64_t i = 0; i < n; i++)
+            dst[i] = OutputPipe::read();
+    }
+};
+
 int main() {
     try {
   #if   FPGA_SIMULATOR
@@ -105,67 +303,125 @@ int main() {
                 << q.get_device().get_info<sycl::info::device::name>()
                 << '\n';
 
-      const uint32_t  N = 2048;
+      // Au-delà des 2048 échantillons de l'ancienne fenêtre awidth<13>, et
+      // pas multiple de kLanes : dernier battement partiel
+      const uint32_t  N = (1 << 20) + 3;
   
       // Allocation des tableaux de Complex
       ComplexF* dst = sycl::malloc_shared<ComplexF>(N, q,
         {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl2)}) ;
+      // Battements : le dernier peut être partiel, ses voies en trop valent 0
+      const uint32_t nbBeats = (N + kLanes - 1) / kLanes;
+      OutBeat* flux = sycl::malloc_shared<OutBeat>(nbBeats, q);
 
-      Complex* src = new Complex [N] ;
-      ac_complex<float>* ref = new ac_complex<float> [N] ;
+      InBeat* beats = sycl::malloc_host<InBeat>(nbBeats, q) ;
+      Complex* src = &beats[0].v[0] ; // vue échantillon par échantillon
+      for (uint32_t i = N ; i < nbBeats * kLanes ; i++)
+        src[i] = Complex{0, 0};
 
-      // Génération des nombres
-      for (uint16_t i = 0 ; i < N ; i++){
-        uint16_t reel = (i + 1) % 128 ;
-        uint16_t imag = (i + 1) % 128 ;
+      // Génération des nombres : parcours pseudo-aléatoire de tout l'espace
+      // 16 bits, zéro et extrêmes compris
+      for (uint32_t i = 0 ; i < N ; i++){
+        int16_t reel = int16_t((i * 2654435761u) >> 16) ;
+        int16_t imag = int16_t(i * 40503u) ;
         Complex nbWrite = {reel,imag} ;
         src[i] = nbWrite ; 
-        InputPipe::write(q,nbWrite);
-        /*std::cout << "src[" << i << "] = (" 
-                            << reel << ", " 
-                            << imag << "j)" << std::endl ; */ // Affichage de la source
       }
+      src[0] = Complex{0, 0};
+      src[1] = Complex{-32768, -32768};
+      // |x|^2 puissance de 2 et résultat à une demi-unité exacte : arrondi
+      // loin de zéro, ±1 ULP
+      const Complex egalites[] = {{-32768, 0}, {0, -32768}, {16384, 16384},
+                                  {16384, -16384}, {-16384, 16384}, {-16384, -16384}};
+      for (uint32_t k = 0 ; k < 6 ; k++)
+        src[2 + k] = egalites[k];
 
       // Le pas de la virgule fixe s1.14
-      const double pas = static_cast<double>(1)  / static_cast<double>(1<<14) ;
+      const double pas = static_cast<double>(1)  / static_cast<double>(1<<SHIFT) ;
       const double tol = pas / static_cast<double>(2) ;
-      //std::cout << "\nAprès inverse multiplicatif :\n";
   
-      // Lancement du kernel
+#if PERF_COUNTERS
+      auto* perf = sycl::malloc_shared<fpga_tools::PerfCounters>(1, q);
+      q.single_task<PerfTimerKernel>(fpga_tools::PerfTimer<PerfIdRef>{perf});
+#endif
+
+      // Variante mémoire : kernel d'alimentation et kernel en parallèle
+      q.single_task<FeederKernel>(Feeder{beats, nbBeats});
       q.single_task<ReferenceKernel>(Reference{dst, N});
+      // Variante flux : alimentation, transformée pipe -> pipe, puits
+      q.single_task<FeederStreamKernel>(FeederS{beats, nbBeats});
+      q.single_task<ReferenceStreamKernel>(ReferenceStream<InputPipeS, OutputPipe>{N});
+      q.single_task<SinkKernel>(Sink{flux, nbBeats});
       q.wait();
-  
-       // Affichage et vérification
-      bool ok = true; 
-      for (uint16_t i = 0 ; i < N ; i++){
-        float a = static_cast<float>(src[i].real());
-        float b = static_cast<float>(src[i].imag());
-        float norm2 = a*a + b*b;
-        ref[i] = { a / norm2, -b / norm2 };
-        std::cout << "dst[" << i << "] = (" << dst[i].real() << ", " 
-                            << dst[i].imag() << "j)     reference :"
-                            << "(" << ref[i].real() << ", " 
-                            << (ref[i].imag()) << "j)     "
-                            << std::endl ;
-        if (((std::abs(static_cast<float>( dst[i].real().to_double()) - ref[i].real()) > tol) ||
-        (std::abs (static_cast<float>( dst[i].imag().to_double()) - ref[i].imag()) > tol))) {
-            std::cout << "dst[" << i << "] = (" << dst[i].real() << ", " 
-                            << dst[i].imag() << "j)     reference :"
-                            << "(" << ref[i].real() << ", " 
-                            << (ref[i].imag()) << "j)     "
-                            << std::endl ;
-            ok = false ;
-        }         
+
+      // Modèle bit à bit sur l'hôte, même chemin que le kernel
+      using fpga_tools::cpu::Complex16;
+      std::vector<Complex16> entree(N), attendu(N);
+      for (uint32_t i = 0 ; i < N ; i++)
+        entree[i] = {src[i].real(), src[i].imag()};
+      fpga_tools::cpu::recipS14<bool(RECIP_FIXED_POINT), SHIFT>(entree.data(), attendu.data(), N);
+
+      // Précision du modèle contre le quotient exact (|x| = 0 exclu)
+      double errMax = 0.0;
+      for (uint32_t i = 0 ; i < N ; i++){
+        const double a = entree[i].real, b = entree[i].imag, norm2 = a*a + b*b;
+        if (norm2 == 0.0)
+          continue;
+        errMax = std::max({errMax, std::abs(attendu[i].real * pas - a / norm2),
+                                   std::abs(attendu[i].imag * pas + b / norm2)});
       }
-  
+      // Le chemin virgule fixe garantit l'arrondi à 0.5 ULP ; le chemin
+      // flottant (1/n2 en float puis produit) le dépasse sur une partie des
+      // entrées, p. ex. (-32768, -8) : son écart est seulement affiché.
+#if RECIP_FIXED_POINT
+      std::cout << "Erreur max du modèle : " << errMax << " (tol " << tol << ")\n";
+#else
+      std::cout << "Erreur max du modèle : " << errMax << " (chemin flottant, "
+                << errMax / pas << " ULP, non borné à 0.5)\n";
+#endif
+
+      // Comparaison d'une sortie kernel au modèle, résumé sans I/O par élément
+      std::vector<Complex16> obtenu(N);
+      auto verifier = [&](auto sortie, const char* nom) {
+        for (uint32_t i = 0 ; i < N ; i++){
+          const ComplexF r = sortie(i);
+          obtenu[i] = {int16_t(r.real().template slc<16>(0).to_int()),
+                       int16_t(r.imag().template slc<16>(0).to_int())};
+        }
+        const fpga_tools::cpu::Ecart e =
+            fpga_tools::cpu::comparerS14(obtenu.data(), attendu.data(), N);
+
+        std::cout << nom << " : échantillons faux " << e.nbErreurs << " / " << N
+                  << ", écart max " << e.maxUlp << " ULP\n";
+        std::cout << "  histogramme ULP :";
+        for (int k = 0; k < fpga_tools::cpu::kHisto; k++)
+          std::cout << ' ' << e.histo[k];
+        std::cout << " (dernière case : >= " << fpga_tools::cpu::kHisto - 1 << ")\n";
+        if (e.nbErreurs) {
+          const uint32_t i = uint32_t(e.premier);
+          const ComplexF r = sortie(i);
+          std::cout << "  premier faux : [" << i << "] = (" << r.real() << ", "
+                    << r.imag() << "j)  attendu (" << attendu[i].real * pas << ", "
+                    << attendu[i].imag * pas << "j)\n";
+        }
+        return e.nbErreurs == 0;
+      };
+
+      bool ok = !RECIP_FIXED_POINT || errMax <= tol;
+      ok &= verifier([&](uint32_t i) { return dst[i]; }, "mémoire");
+      ok &= verifier([&](uint32_t i) { return flux[i / kLanes].v[i % kLanes]; }, "flux");
+#if PERF_COUNTERS
+      // Octets écrits en mémoire par la variante mémoire
+      fpga_tools::printPerf(std::cout, "Reference", *perf, N, uint64_t(N) * sizeof(ComplexF),
+                            kFmaxMHz);
+      sycl::free(perf, q);
+#endif
       std::cout << (ok ? "PASSED\n" : "FAILED\n");
-      
-  
+
       sycl::free(dst, q);
-      delete[] src ;
+      sycl::free(flux, q);
+      sycl::free(beats, q);
       return ok ? EXIT_SUCCESS : EXIT_FAILURE; 
-
-      return 0 ;
     } catch (const sycl::exception& e) {
       std::cerr << "SYCL exception : " << e.what() << '\n';
       return EXIT_FAILURE;
@@ -0,0 +1,329 @@
+#ifndef __REFERENCE_CPU_HPP__
+#define __REFERENCE_CPU_HPP__
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// -----------------------------------------------------------------------------
+// Backend CPU de dst[i] = conj(src[i]) / |src[i]|^2 (modèle de référence du
+// kernel Reference de referenceIP.cpp et repli en production)
+//
+// Sémantique, identique en scalaire et en SIMD (donc bit à bit) :
+//   n2  = float(a² + b²)       carré de la norme exact en entier, un arrondi
+//   inv = 1 / n2               une seule inversion par échantillon
+//   dst = (a · inv, -b · inv)  et dst = 0 si src = 0
+//
+// Les complexes 16 bits sont lus par paires (re, im) dans un mot 32 bits :
+// _mm*_madd_epi16 donne directement a² + b² ; 8 échantillons par itération en
+// AVX2, 16 en AVX-512 (AVX512BW). Sans AVX2 on garde la boucle scalaire.
+//
+// Mode Recip::Rapide : inv = rcp(n2) raffiné par une itération de Newton
+// y (2 - n2 y) au lieu de la division. Écart max mesuré (5·10^8 couples
+// (a, b) aléatoires + grille ±256), sur chaque partie :
+//                     vs Exact    vs quotient correctement arrondi
+//   AVX2   (rcp 12 b)  4 ULP       5 ULP
+//   AVX-512 (rcp14)    2 ULP       3 ULP
+// Le résultat dépend alors du jeu d'instructions et n'est plus un modèle bit
+// à bit ; la queue scalaire reste en division.
+// -----------------------------------------------------------------------------
+
+namespace fpga_tools {
+namespace cpu {
+
+/// Complexe à parties réelles et imaginaires sur 16 bits
+struct Complex16 {
+  int16_t real;
+  int16_t imag;
+};
+
+/// Alias pour un complexe en simple précision
+using ComplexF = std::complex<float>;
+
+enum class Recip { Exact, Rapide };
+
+// ---------- Un échantillon ----------------------------------------------------
+inline ComplexF invertConjNorm2(Complex16 x) {
+  const int32_t a = x.real, b = x.imag;
+  // a² + b² <= 2^31 : tient en non signé
+  const uint32_t n2 = uint32_t(a * a) + uint32_t(b * b);
+  if (n2 == 0)
+    return ComplexF(0.0f, 0.0f);
+  const float inv = 1.0f / float(n2);
+  return ComplexF(float(a) * inv, float(-b) * inv);
+}
+
+// ---------- Lot contigu, un seul thread ---------------------------------------
+template <Recip R = Recip::Exact>
+void invertConjNorm2Lot(const Complex16* src, ComplexF* dst, size_t n) {
+  size_t i = 0;
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+  float* d = reinterpret_cast<float*>(dst);
+  // Entrelacement (re, im) : voies 128 bits lo.q, hi.q alternées
+  const __m512i idx0 = _mm512_setr_epi32(0, 1, 2, 3, 16, 17, 18, 19,
+                                         4, 5, 6, 7, 20, 21, 22, 23);
+  const __m512i idx1 = _mm512_setr_epi32(8, 9, 10, 11, 24, 25, 26, 27,
+                                         12, 13, 14, 15, 28, 29, 30, 31);
+  for (; i + 16 <= n; i += 16) {
+    const __m512i x = _mm512_loadu_si512(src + i);
+    const __m512i n2i = _mm512_madd_epi16(x, x);
+    const __m512 a = _mm512_cvtepi32_ps(_mm512_srai_epi32(_mm512_slli_epi32(x, 16), 16));
+    const __m512 b = _mm512_cvtepi32_ps(_mm512_srai_epi32(x, 16));
+    // (-32768, -32768) donne 2^31 : conversion non signée
+    const __m512 n2 = _mm512_cvtepu32_ps(n2i);
+
+    __m512 inv;
+    if constexpr (R == Recip::Exact) {
+      inv = _mm512_div_ps(_mm512_set1_ps(1.0f), n2);
+    } else {
+      const __m512 y = _mm512_rcp14_ps(n2);
+      inv = _mm512_mul_ps(y, _mm512_sub_ps(_mm512_set1_ps(2.0f), _mm512_mul_ps(n2, y)));
+    }
+    const __mmask16 nz = _mm512_test_epi32_mask(n2i, n2i);
+    const __m512 re = _mm512_maskz_mul_ps(nz, a, inv);
+    const __m512 im = _mm512_maskz_mul_ps(nz, _mm512_sub_ps(_mm512_setzero_ps(), b), inv);
+
+    const __m512 lo = _mm512_unpacklo_ps(re, im), hi = _mm512_unpackhi_ps(re, im);
+    _mm512_storeu_ps(d + 2 * i, _mm512_permutex2var_ps(lo, idx0, hi));
+    _mm512_storeu_ps(d + 2 * i + 16, _mm512_permutex2var_ps(lo, idx1, hi));
+  }
+#elif defined(__AVX2__)
+  float* d = reinterpret_cast<float*>(dst);
+  const __m256 signe = _mm256_set1_ps(-0.0f);
+  for (; i + 8 <= n; i += 8) {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i n2i = _mm256_madd_epi16(x, x);
+    const __m256 a = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16));
+    const __m256 b = _mm256_cvtepi32_ps(_mm256_srai_epi32(x, 16));
+    // Seul (-32768, -32768) déborde (2^31 lu -2^31) : |.| est exact
+    const __m256 n2 = _mm256_andnot_ps(signe, _mm256_cvtepi32_ps(n2i));
+
+    __m256 inv;
+    if constexpr (R == Recip::Exact) {
+      inv = _mm256_div_ps(_mm256_set1_ps(1.0f), n2);
+    } else {
+      const __m256 y = _mm256_rcp_ps(n2);
+      inv = _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(n2, y)));
+    }
+    // src = 0 : inv = inf, 0 · inf = NaN, remis à 0
+    const __m256 nz = _mm256_castsi256_ps(
+        _mm256_xor_si256(_mm256_cmpeq_epi32(n2i, _mm256_setzero_si256()),
+                         _mm256_set1_epi32(-1)));
+    const __m256 re = _mm256_and_ps(nz, _mm256_mul_ps(a, inv));
+    const __m256 im = _mm256_and_ps(nz, _mm256_mul_ps(_mm256_sub_ps(_mm256_setzero_ps(), b), inv));
+
+    const __m256 lo = _mm256_unpacklo_ps(re, im), hi = _mm256_unpackhi_ps(re, im);
+    _mm256_storeu_ps(d + 2 * i, _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(d + 2 * i + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+  }
+#endif
+
+  for (; i < n; i++)
+    dst[i] = invertConjNorm2(src[i]);
+}
+
+// ---------- Répartition sur les threads --------------------------------------
+// f(i0, n) sur des morceaux de kMorceau échantillons tirés par compteur
+// atomique. nbThreads = 0 : autant que de coeurs ; un seul thread sous kMorceau.
+constexpr size_t kMorceau = size_t(1) << 16;
+
+template <typename F>
+void repartir(size_t n, unsigned nbThreads, F&& f) {
+  const uint64_t nbTaches = (n + kMorceau - 1) / kMorceau;
+
+  if (nbThreads == 0)
+    nbThreads = std::max(1u, std::thread::hardware_concurrency());
+  nbThreads = unsigned(std::min<uint64_t>(nbThreads, nbTaches));
+
+  std::atomic<uint64_t> suivante{0};
+  auto travail = [&]() {
+    for (uint64_t t; (t = suivante.fetch_add(1)) < nbTaches;) {
+      const size_t i0 = size_t(t) * kMorceau;
+      f(i0, std::min(kMorceau, n - i0));
+    }
+  };
+
+  if (nbThreads <= 1) {
+    travail();
+    return;
+  }
+  std::vector<std::thread> pool;
+  for (unsigned k = 0; k < nbThreads; k++)
+    pool.emplace_back(travail);
+  for (auto& th : pool)
+    th.join();
+}
+
+// ---------- Lot complet, multithread -----------------------------------------
+template <Recip R = Recip::Exact>
+void invertConjNorm2(const Complex16* src, ComplexF* dst, size_t n, unsigned nbThreads = 0) {
+  repartir(n, nbThreads, [&](size_t i0, size_t m) {
+    invertConjNorm2Lot<R>(src + i0, dst + i0, m);
+  });
+}
+
+// =============================================================================
+// Modèle bit à bit du kernel Reference (sortie s1.14, ac_fixed<16, 2>)
+//
+// Les sorties sont manipulées en bits bruts : Complex16 {re, im} où chaque
+// partie vaut round(valeur · 2^Shift). Deux chemins, comme dans le kernel :
+//   recipS14Fixe     : RECIP_FIXED_POINT = 1 (LUT + Newton, tout en entier)
+//   recipS14Flottant : RECIP_FIXED_POINT = 0 (division float puis arrondi)
+// =============================================================================
+
+// Amorce de 1/m pour m = 1.f dans [1, 2), indexée par les 6 bits qui suivent
+// le bit de tête, évaluée au milieu de l'intervalle, en u0.16. Partagée avec
+// le kernel pour que la table soit la même des deux côtés.
+constexpr int kLutBits = 6;
+constexpr int kLutSize = 1 << kLutBits;
+
+struct RecipLut {
+  uint16_t v[kLutSize];
+  constexpr RecipLut() : v() {
+    for (int i = 0; i < kLutSize; i++)
+      v[i] = uint16_t(65536.0 / (1.0 + (i + 0.5) / kLutSize) + 0.5);
+  }
+};
+constexpr RecipLut kRecipLut{};
+
+// round(v · y / 2^s), demi-unité loin de zéro, y en u2.30
+inline int16_t scaleRound(int32_t v, uint64_t y, int s) {
+  const uint64_t m = uint64_t(v < 0 ? -int64_t(v) : int64_t(v));
+  const uint64_t q = (m * y + (uint64_t(1) << (s - 1))) >> s;
+  return int16_t(v < 0 ? -int64_t(q) : int64_t(q));
+}
+
+template <int Shift = 14>
+inline Complex16 recipS14Fixe(Complex16 x) {
+  const int32_t a = x.real, b = x.imag;
+  const uint32_t n2 = uint32_t(a * a) + uint32_t(b * b);
+  if (n2 == 0)
+    return Complex16{0, 0};
+
+  // n2 = m · 2^p, m en u1.31, 1/m en u2.30
+  int p = 31;
+  while (!(n2 >> p))
+    p--;
+  const uint64_t m = uint64_t(n2) << (31 - p);
+  uint64_t y = uint64_t(kRecipLut.v[(m >> (31 - kLutBits)) & (kLutSize - 1)]) << 14;
+  for (int it = 0; it < 2; it++) {
+    const uint64_t t = ((m * y) >> 31) & 0xffffffffu;
+    const uint64_t d = ((uint64_t(1) << 31) - t) & 0xffffffffu;
+    y = ((y * d) >> 30) & 0xffffffffu;
+  }
+  // m = 1 : Newton converge par en dessous et s'arrête juste sous 2^30, ce
+  // qui arrondirait les demi-unités exactes vers zéro (p. ex. (-32768, 0))
+  if (m == (uint64_t(1) << 31))
+    y = uint64_t(1) << 30;
+
+  const int s = 30 - Shift + p;
+  return Complex16{scaleRound(a, y, s), scaleRound(-b, y, s)};
+}
+
+template <int Shift = 14>
+inline Complex16 recipS14Flottant(Complex16 x) {
+  const float re_f = static_cast<float>(x.real);
+  const float im_f = static_cast<float>(x.imag);
+  const float norm2 = re_f * re_f + im_f * im_f;
+  if (norm2 == 0.0f)
+    return Complex16{0, 0};
+  const float norm2_inv = 1.0f / norm2;
+
+  const float scaled_re = re_f * norm2_inv * (1 << Shift);
+  const float scaled_im = -im_f * norm2_inv * (1 << Shift);
+  return Complex16{static_cast<int16_t>(scaled_re + (scaled_re >= 0.0f ? 0.5f : -0.5f)),
+                   static_cast<int16_t>(scaled_im + (scaled_im >= 0.0f ? 0.5f : -0.5f))};
+}
+
+// Modèle sur un lot, multithread
+template <bool Fixe = true, int Shift = 14>
+void recipS14(const Complex16* src, Complex16* dst, size_t n, unsigned nbThreads = 0) {
+  repartir(n, nbThreads, [&](size_t i0, size_t m) {
+    for (size_t i = i0; i < i0 + m; i++)
+      dst[i] = Fixe ? recipS14Fixe<Shift>(src[i]) : recipS14Flottant<Shift>(src[i]);
+  });
+}
+
+// ---------- Comparateur ------------------------------------------------------
+// Compare deux tableaux de sorties brutes, partie par partie, sans I/O :
+//   histo[k] : nombre de parties à k ULP (2^-Shift) d'écart, k < kHisto - 1,
+//              la dernière case cumule les écarts >= kHisto - 1
+//   maxUlp, nbErreurs (échantillons avec au moins une partie différente) et
+//   premier (indice du premier échantillon faux, n si aucun)
+constexpr int kHisto = 8;
+
+struct Ecart {
+  uint64_t histo[kHisto] = {};
+  uint32_t maxUlp = 0;
+  uint64_t nbErreurs = 0;
+  size_t premier = 0;
+};
+
+inline Ecart comparerS14(const Complex16* obtenu, const Complex16* attendu, size_t n) {
+  Ecart e;
+  e.premier = n;
+  size_t j = 0;
+
+#if defined(__AVX2__)
+  // 8 échantillons (16 parties) par itération. L'écart |o - r| est exact sur
+  // 16 bits non signés : max - min après décalage de 2^15. Comptage par case
+  // via cmpeq + movemask (2 bits de masque par partie 16 bits).
+  const __m256i biais = _mm256_set1_epi16(int16_t(0x8000));
+  const __m256i borne = _mm256_set1_epi16(kHisto - 1);
+  __m256i vmax = _mm256_setzero_si256();
+  for (; j + 8 <= n; j += 8) {
+    const __m256i vo = _mm256_xor_si256(biais,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(obtenu + j)));
+    const __m256i vr = _mm256_xor_si256(biais,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(attendu + j)));
+    const __m256i d = _mm256_sub_epi16(_mm256_max_epu16(vo, vr), _mm256_min_epu16(vo, vr));
+    vmax = _mm256_max_epu16(vmax, d);
+
+    const __m256i c = _mm256_min_epu16(d, borne);
+    for (int k = 0; k < kHisto; k++)
+      e.histo[k] += unsigned(__builtin_popcount(unsigned(_mm256_movemask_epi8(
+                        _mm256_cmpeq_epi16(c, _mm256_set1_epi16(int16_t(k))))))) / 2;
+
+    // Un échantillon est faux si son mot 32 bits d'écart est non nul
+    const unsigned justes = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(
+        _mm256_cmpeq_epi32(d, _mm256_setzero_si256()))));
+    if (justes != 0xffu) {
+      e.nbErreurs += 8 - unsigned(__builtin_popcount(justes));
+      if (e.premier == n)
+        e.premier = j + unsigned(__builtin_ctz(~justes));
+    }
+  }
+  alignas(32) uint16_t m[16];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(m), vmax);
+  for (int k = 0; k < 16; k++)
+    e.maxUlp = std::max<uint32_t>(e.maxUlp, m[k]);
+#endif
+
+  for (; j < n; j++) {
+    const uint32_t dr = uint32_t(std::abs(int32_t(obtenu[j].real) - attendu[j].real));
+    const uint32_t di = uint32_t(std::abs(int32_t(obtenu[j].imag) - attendu[j].imag));
+    e.histo[std::min<uint32_t>(dr, kHisto - 1)]++;
+    e.histo[std::min<uint32_t>(di, kHisto - 1)]++;
+    e.maxUlp = std::max({e.maxUlp, dr, di});
+    if (dr | di) {
+      e.nbErreurs++;
+      if (e.premier == n)
+        e.premier = j;
+    }
+  }
+  return e;
+}
+
+} // namespace cpu
+} // namespace fpga_tools
+
+#endif //__REFERENCE_CPU_HPP__
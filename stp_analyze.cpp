@@ -0,0 +1,421 @@
+// Analyse d'une capture SignalTap (export CSV) de ports Avalon-MM :
+// débit atteint, longueur moyenne des bursts, cycles de stall, latence de
+// lecture et pas d'adresse, port par port.
+//
+// Compilation : g++ -std=c++17 -O2 stp_analyze.cpp -o stp_analyze
+// Usage       : ./stp_analyze [--mhz F] [--port motif] capture.csv [autre.csv ...]
+//   --mhz F     horloge d'échantillonnage de SignalTap (défaut 100 MHz)
+//   --port m    ne garder que les ports dont le nom contient m
+// Avec plusieurs captures (p. ex. maxburst<4> puis <16>), un tableau final
+// compare le débit et la longueur de burst de chaque port.
+//
+// Les ports sont reconnus aux suffixes Avalon des signaux : _address,
+// _burstcount, _byteenable, _readdata, _writedata, _read, _write,
+// _readdatavalid, _waitrequest. Un signal absent prend sa valeur neutre
+// (burstcount 1, waitrequest 0).
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ---------- Lecture du CSV ----------------------------------------------------
+enum class Base { Hex, Dec, Bin };
+
+std::string trim(const std::string& s) {
+  const size_t a = s.find_first_not_of(" \t\r\n");
+  const size_t b = s.find_last_not_of(" \t\r\n");
+  return a == std::string::npos ? std::string() : s.substr(a, b - a + 1);
+}
+
+std::vector<std::string> split(const std::string& ligne) {
+  std::vector<std::string> champs;
+  std::stringstream ss(ligne);
+  std::string c;
+  while (std::getline(ss, c, ','))
+    champs.push_back(trim(c));
+  return champs;
+}
+
+// "X" ou chiffre invalide : valeur inconnue
+bool parse(const std::string& s, Base base, uint64_t& v) {
+  if (s.empty())
+    return false;
+  v = 0;
+  for (char c : s) {
+    int d;
+    if (c >= '0' && c <= '9') d = c - '0';
+    else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+    else if (c == '-' && base == Base::Dec) continue;
+    else return false;
+    const int r = base == Base::Hex ? 16 : base == Base::Dec ? 10 : 2;
+    if (d >= r)
+      return false;
+    v = v * r + d;
+  }
+  return true;
+}
+
+// ---------- Ports Avalon ------------------------------------------------------
+enum Role { Address, Burst, ByteEn, RData, WData, Read, Write, RValid, Wait, kNbRoles };
+const char* const kRoles[kNbRoles] = {"address", "burstcount", "byteenable", "readdata",
+                                      "writedata", "read", "write", "readdatavalid",
+                                      "waitrequest"};
+
+struct Colonne {
+  int index = -1;
+  int largeur = 1;
+  Base base = Base::Bin;
+};
+
+struct Port {
+  std::string nom;
+  Colonne col[kNbRoles];
+  bool a(Role r) const { return col[r].index >= 0; }
+  int octetsParBeat() const {
+    const int w = a(RData) ? col[RData].largeur : a(WData) ? col[WData].largeur : 32;
+    return std::max(1, w / 8);
+  }
+};
+
+// "xxx_port_0_0_r_burstcount[3..0]" -> ("xxx_port_0_0_r", Burst, 4)
+bool decouper(const std::string& signal, std::string& port, Role& role, int& largeur) {
+  std::string nom = signal;
+  largeur = 1;
+  const size_t crochet = nom.find('[');
+  if (crochet != std::string::npos) {
+    const size_t points = nom.find("..", crochet);
+    if (points == std::string::npos)
+      return false; // bit isolé d'un bus
+    largeur = std::atoi(nom.c_str() + crochet + 1) - std::atoi(nom.c_str() + points + 2) + 1;
+    nom = nom.substr(0, crochet);
+  }
+  // Suffixe le plus long d'abord : readdatavalid avant read
+  int meilleur = -1;
+  size_t lg = 0;
+  for (int r = 0; r < kNbRoles; ++r) {
+    const std::string suffixe = std::string("_") + kRoles[r];
+    if (nom.size() > suffixe.size() && suffixe.size() > lg &&
+        nom.compare(nom.size() - suffixe.size(), suffixe.size(), suffixe) == 0) {
+      meilleur = r;
+      lg = suffixe.size();
+    }
+  }
+  if (meilleur < 0)
+    return false;
+  port = nom.substr(0, nom.size() - lg);
+  role = Role(meilleur);
+  return true;
+}
+
+// ---------- Statistiques par port --------------------------------------------
+struct Stats {
+  uint64_t cycles = 0, inconnus = 0;
+  uint64_t cyclesReq = 0, stalls = 0;
+  uint64_t cmdLect = 0, cmdEcr = 0;
+  uint64_t beatsLect = 0, beatsEcr = 0;
+  uint64_t premier = UINT64_MAX, dernier = 0; // fenêtre active (cycles)
+  std::map<uint64_t, uint64_t> bursts;         // longueur -> nombre
+  std::map<uint64_t, uint64_t> latences;       // cycles -> nombre
+  std::map<int64_t, uint64_t> pas;             // octets -> nombre
+  uint64_t sequentiels = 0, nbPas = 0;
+
+  // état
+  std::deque<std::pair<uint64_t, uint64_t>> enVol; // (cycle d'émission, beats restants)
+  uint64_t resteEcr = 0;
+  bool adresseValide = false;
+  uint64_t adressePrec = 0, burstPrec = 0;
+
+  void actif(uint64_t t) {
+    premier = std::min(premier, t);
+    dernier = std::max(dernier, t);
+  }
+  uint64_t octets(int parBeat) const { return (beatsLect + beatsEcr) * uint64_t(parBeat); }
+  double burstMoyen() const {
+    uint64_t n = 0, s = 0;
+    for (auto [l, c] : bursts) { n += c; s += l * c; }
+    return n ? double(s) / double(n) : 0.0;
+  }
+};
+
+void commande(Stats& s, uint64_t adresse, uint64_t burst, int parBeat) {
+  s.bursts[burst]++;
+  if (s.adresseValide) {
+    const int64_t d = int64_t(adresse) - int64_t(s.adressePrec);
+    s.pas[d]++;
+    s.nbPas++;
+    if (uint64_t(d) == s.burstPrec * uint64_t(parBeat))
+      s.sequentiels++;
+  }
+  s.adresseValide = true;
+  s.adressePrec = adresse;
+  s.burstPrec = burst;
+}
+
+// Un cycle d'horloge pour un port
+void cycle(const Port& p, Stats& s, const std::vector<std::string>& champs, uint64_t t) {
+  uint64_t v[kNbRoles] = {0, 1, 0, 0, 0, 0, 0, 0, 0};
+  for (int r = 0; r < kNbRoles; ++r) {
+    if (!p.a(Role(r)))
+      continue;
+    const Colonne& c = p.col[r];
+    if (size_t(c.index) >= champs.size() || !parse(champs[c.index], c.base, v[r])) {
+      if (r == Read || r == Write || r == RValid || r == Wait || r == Burst) {
+        s.inconnus++;
+        return;
+      }
+      v[r] = 0;
+    }
+  }
+  s.cycles++;
+  const int parBeat = p.octetsParBeat();
+  const bool attente = v[Wait] != 0;
+  const uint64_t burst = std::max<uint64_t>(1, v[Burst]);
+
+  if (v[Read] || v[Write]) {
+    s.cyclesReq++;
+    if (attente)
+      s.stalls++;
+  }
+
+  // Lecture acceptée : une commande, burst beats attendus
+  if (v[Read] && !attente) {
+    s.cmdLect++;
+    commande(s, v[Address], burst, parBeat);
+    s.enVol.emplace_back(t, burst);
+    s.actif(t);
+  }
+
+  // Données lues : la première d'une commande donne la latence
+  if (v[RValid]) {
+    s.beatsLect++;
+    s.actif(t);
+    if (!s.enVol.empty()) {
+      auto& tete = s.enVol.front();
+      if (tete.first != UINT64_MAX) {
+        s.latences[t - tete.first]++;
+        tete.first = UINT64_MAX;
+      }
+      if (--tete.second == 0)
+        s.enVol.pop_front();
+    }
+  }
+
+  // Écriture : le premier beat porte l'adresse et la longueur du burst
+  if (v[Write] && !attente) {
+    s.beatsEcr++;
+    s.actif(t);
+    if (s.resteEcr == 0) {
+      s.cmdEcr++;
+      commande(s, v[Address], burst, parBeat);
+      s.resteEcr = burst;
+    }
+    s.resteEcr--;
+  }
+}
+
+// ---------- Analyse d'une capture ---------------------------------------------
+struct Resultat {
+  std::string fichier;
+  std::vector<Port> ports;
+  std::vector<Stats> stats;
+};
+
+bool analyser(const std::string& fichier, const std::string& motif, Resultat& res) {
+  std::ifstream f(fichier);
+  if (!f) {
+    std::cerr << fichier << " : lecture impossible\n";
+    return false;
+  }
+  res.fichier = fichier;
+
+  // Groupes : base d'affichage de chaque bus
+  std::map<std::string, Base> bases;
+  std::string ligne;
+  while (std::getline(f, ligne) && trim(ligne) != "Data:") {
+    const auto champs = split(ligne);
+    if (champs.size() < 2)
+      continue;
+    const std::string& nom = champs.front();
+    const std::string& b = champs.back();
+    const std::string bus = trim(nom.substr(0, nom.find('=')));
+    bases[bus] = b.find("hex") != std::string::npos   ? Base::Hex
+                 : b.find("decimal") != std::string::npos ? Base::Dec
+                                                          : Base::Bin;
+  }
+
+  // En-tête des données
+  if (!std::getline(f, ligne)) {
+    std::cerr << fichier << " : pas de section Data\n";
+    return false;
+  }
+  const auto entete = split(ligne);
+  std::map<std::string, size_t> index;
+  for (size_t i = 1; i < entete.size(); ++i) {
+    std::string port;
+    Role role;
+    int largeur;
+    if (!decouper(entete[i], port, role, largeur))
+      continue;
+    if (!motif.empty() && port.find(motif) == std::string::npos)
+      continue;
+    auto it = index.find(port);
+    if (it == index.end()) {
+      it = index.emplace(port, res.ports.size()).first;
+      res.ports.push_back(Port{port, {}});
+    }
+    Colonne& c = res.ports[it->second].col[role];
+    c.index = int(i);
+    c.largeur = largeur;
+    auto b = bases.find(entete[i]);
+    c.base = b != bases.end() ? b->second : Base::Bin;
+  }
+  // Un port sans read ni write n'est pas exploitable
+  res.ports.erase(std::remove_if(res.ports.begin(), res.ports.end(),
+                                 [](const Port& p) { return !p.a(Read) && !p.a(Write); }),
+                  res.ports.end());
+  res.stats.assign(res.ports.size(), Stats{});
+
+  uint64_t t = 0;
+  while (std::getline(f, ligne)) {
+    if (trim(ligne).empty())
+      continue;
+    const auto champs = split(ligne);
+    for (size_t k = 0; k < res.ports.size(); ++k)
+      cycle(res.ports[k], res.stats[k], champs, t);
+    t++;
+  }
+  return true;
+}
+
+// ---------- Rapport -----------------------------------------------------------
+template <typename Map>
+void histogramme(const Map& m, const char* unite, size_t maxLignes) {
+  uint64_t total = 0, maxi = 0;
+  for (auto [k, n] : m) { total += n; maxi = std::max(maxi, n); }
+  std::vector<std::pair<typename Map::key_type, uint64_t>> v(m.begin(), m.end());
+  if (v.size() > maxLignes) {
+    std::partial_sort(v.begin(), v.begin() + maxLignes, v.end(),
+                      [](auto& a, auto& b) { return a.second > b.second; });
+    v.resize(maxLignes);
+    std::sort(v.begin(), v.end());
+  }
+  for (auto [k, n] : v)
+    std::cout << "      " << std::setw(8) << k << ' ' << std::setw(4) << unite << std::setw(8) << n
+              << std::setw(7) << std::fixed << std::setprecision(1) << 100.0 * n / total << " %  "
+              << std::string(size_t(30 * n / maxi), '#') << '\n';
+}
+
+void rapport(const Resultat& res, double mhz) {
+  std::cout << "=== " << res.fichier << " (" << mhz << " MHz)\n";
+  for (size_t k = 0; k < res.ports.size(); ++k) {
+    const Port& p = res.ports[k];
+    const Stats& s = res.stats[k];
+    const int parBeat = p.octetsParBeat();
+    const uint64_t fenetre = s.premier <= s.dernier ? s.dernier - s.premier + 1 : 0;
+    const double octets = double(s.octets(parBeat));
+    auto gbs = [&](uint64_t cycles) { return cycles ? octets * mhz * 1e6 / double(cycles) / 1e9 : 0.0; };
+
+    std::cout << "\n  " << p.nom << "  (" << 8 * parBeat << " bits)\n" << std::fixed
+              << "    cycles          : " << s.cycles << " capturés, " << fenetre << " actifs";
+    if (s.inconnus)
+      std::cout << ", " << s.inconnus << " ignorés (X)";
+    std::cout << "\n    commandes       : " << s.cmdLect << " lectures, " << s.cmdEcr << " écritures\n"
+              << "    beats           : " << s.beatsLect << " lus, " << s.beatsEcr << " écrits ("
+              << std::setprecision(0) << octets << " octets)\n"
+              << std::setprecision(3)
+              << "    débit           : " << gbs(s.cycles) << " GB/s sur la capture, "
+              << gbs(fenetre) << " GB/s sur la fenêtre active ("
+              << (fenetre ? octets / double(fenetre) / parBeat : 0.0) << " beat/cycle)\n"
+              << std::setprecision(2)
+              << "    burst moyen     : " << s.burstMoyen() << " beats\n"
+              << "    stalls          : " << s.stalls << " cycles de waitrequest sur "
+              << s.cyclesReq << " cycles de requête ("
+              << (s.cyclesReq ? 100.0 * s.stalls / s.cyclesReq : 0.0) << " %)\n";
+    if (!s.bursts.empty()) {
+      std::cout << "    longueurs de burst :\n";
+      histogramme(s.bursts, "", 8);
+    }
+    if (!s.latences.empty()) {
+      uint64_t n = 0, somme = 0;
+      for (auto [l, c] : s.latences) { n += c; somme += l * c; }
+      std::cout << "    latence de lecture : min " << s.latences.begin()->first << ", moy "
+                << double(somme) / double(n) << ", max " << s.latences.rbegin()->first
+                << " cycles\n";
+      histogramme(s.latences, "cyc", 10);
+    }
+    if (s.nbPas) {
+      std::cout << "    pas d'adresse : " << std::setprecision(1)
+                << 100.0 * s.sequentiels / s.nbPas << " % séquentiels (pas = burst)\n";
+      histogramme(s.pas, "o", 6);
+    }
+  }
+  std::cout << '\n';
+}
+
+void comparer(const std::vector<Resultat>& res, double mhz) {
+  std::cout << "=== Comparaison (GB/s fenêtre active / burst moyen)\n";
+  std::map<std::string, std::vector<std::pair<double, double>>> table;
+  for (size_t f = 0; f < res.size(); ++f)
+    for (size_t k = 0; k < res[f].ports.size(); ++k) {
+      const Stats& s = res[f].stats[k];
+      const uint64_t fenetre = s.premier <= s.dernier ? s.dernier - s.premier + 1 : 0;
+      const double gbs = fenetre ? double(s.octets(res[f].ports[k].octetsParBeat())) * mhz * 1e6 /
+                                       double(fenetre) / 1e9
+                                 : 0.0;
+      auto& ligne = table[res[f].ports[k].nom];
+      ligne.resize(res.size(), {0.0, 0.0});
+      ligne[f] = {gbs, s.burstMoyen()};
+    }
+  for (auto& [nom, ligne] : table) {
+    std::cout << "  " << nom << '\n';
+    for (size_t f = 0; f < ligne.size(); ++f)
+      std::cout << "    " << std::setw(40) << std::left << res[f].fichier << std::right
+                << std::fixed << std::setprecision(3) << std::setw(9) << ligne[f].first
+                << " GB/s " << std::setprecision(2) << std::setw(7) << ligne[f].second
+                << " beats\n";
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  double mhz = 100.0;
+  std::string motif;
+  std::vector<std::string> fichiers;
+  for (int i = 1; i < argc; ++i) {
+    const std::string a = argv[i];
+    if (a == "--mhz" && i + 1 < argc)
+      mhz = std::atof(argv[++i]);
+    else if (a == "--port" && i + 1 < argc)
+      motif = argv[++i];
+    else
+      fichiers.push_back(a);
+  }
+  if (fichiers.empty() || mhz <= 0.0) {
+    std::cerr << "Usage : " << argv[0] << " [--mhz F] [--port motif] capture.csv [autre.csv ...]\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Resultat> res;
+  for (const auto& f : fichiers) {
+    Resultat r;
+    if (!analyser(f, motif, r))
+      return EXIT_FAILURE;
+    rapport(r, mhz);
+    res.push_back(std::move(r));
+  }
+  if (res.size() > 1)
+    comparer(res, mhz);
+  return EXIT_SUCCESS;
+}
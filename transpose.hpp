@@ -0,0 +1,817 @@
+#ifndef __TRANSPOSE_HPP__
+#define __TRANSPOSE_HPP__
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include <sycl/ext/intel/ac_types/ac_complex.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "perf_counters.hpp"
+#include "transpose_cpu.hpp"
+
+// -----------------------------------------------------------------------------
+// Bibliothèque de transposition (header-only)
+//
+// Remplace les variantes copiées-collées (transpose.cpp, transpose_complexe*,
+// transpose_parrale_task.cpp, ...) par deux kernels paramétrés :
+//   – Transpose       : mémoire -> mémoire, par tuiles TileRows × TileCols
+//   – TransposeStream : pipe -> mémoire, par bandes de StripeRows lignes
+//   – TransposePipe   : pipe -> pipe, réordonnancement entrelacé par bandes
+//   – TransposePipeFrame : pipe -> pipe, vraie transposée (trame entière)
+//   – TransposeInPlace: matrice carrée transposée dans son propre buffer
+//   – TransposeRing   : Transpose piloté par un anneau de descripteurs
+// TransposeMultiCU répartit une trame sur plusieurs instances de Transpose.
+// Le type d'élément, la taille des tuiles, le nombre de buffers et la largeur
+// du bus sont fixés à la compilation, comme la sonde de performance Perf de
+// Transpose et TransposeStream (NoPerf par défaut, voir perf_counters.hpp).
+// -----------------------------------------------------------------------------
+
+namespace fpga_tools {
+
+// ---------- Caractéristiques par type d'élément ------------------------------
+// kBits       : taille d'un élément sur le bus
+// kTileRows/Cols, kNumBuffers : configuration par défaut pour ce type
+// make / same : génération et comparaison côté hôte pour les tests
+template <typename T> struct ElemTraits; // type non supporté => erreur
+
+template <> struct ElemTraits<int> {
+  static constexpr int kBits = 32;
+  static constexpr int kTileRows = 32;
+  static constexpr int kTileCols = 32;
+  static constexpr int kNumBuffers = 4;
+  static int make(uint32_t v) { return int(v); }
+  static bool same(int a, int b) { return a == b; }
+};
+
+template <> struct ElemTraits<sycl::vec<float, 2>> {
+  using T = sycl::vec<float, 2>;
+  static constexpr int kBits = 64;
+  static constexpr int kTileRows = 32;
+  static constexpr int kTileCols = 32;
+  static constexpr int kNumBuffers = 4;
+  static T make(uint32_t v) { return T(float(v), float(v) + 0.5f); }
+  static bool same(const T& a, const T& b) { return a[0] == b[0] && a[1] == b[1]; }
+};
+
+template <> struct ElemTraits<ac_complex<float>> {
+  using T = ac_complex<float>;
+  static constexpr int kBits = 64;
+  static constexpr int kTileRows = 32;
+  static constexpr int kTileCols = 32;
+  static constexpr int kNumBuffers = 4;
+  static T make(uint32_t v) { return T(float(v), float(v) + 0.5f); }
+  static bool same(const T& a, const T& b) { return a.r() == b.r() && a.i() == b.i(); }
+};
+
+template <> struct ElemTraits<ac_complex<int16_t>> {
+  using T = ac_complex<int16_t>;
+  static constexpr int kBits = 32;
+  static constexpr int kTileRows = 32;
+  static constexpr int kTileCols = 32;
+  static constexpr int kNumBuffers = 4;
+  static T make(uint32_t v) { return T(int16_t(v), int16_t(v + 1)); }
+  static bool same(const T& a, const T& b) { return a.r() == b.r() && a.i() == b.i(); }
+};
+
+// ---------- Propriétés des interfaces ----------------------------------------
+template <typename U>
+using ConduitArg = sycl::ext::oneapi::experimental::annotated_arg<
+    U, decltype(sycl::ext::oneapi::experimental::properties{
+           sycl::ext::intel::experimental::conduit})>;
+
+template <int BL, int BusWidth>
+using InProps = decltype(
+    sycl::ext::oneapi::experimental::properties{
+        sycl::ext::intel::experimental::buffer_location<BL>,
+        sycl::ext::intel::experimental::dwidth<BusWidth>,
+        sycl::ext::intel::experimental::maxburst<4>,
+        sycl::ext::intel::experimental::latency<0>,
+        sycl::ext::intel::experimental::read_write_mode_read,
+        sycl::ext::oneapi::experimental::alignment<BusWidth / 8>});
+
+template <int BL, int BusWidth, int MaxBurst = 4>
+using OutProps = decltype(
+    sycl::ext::oneapi::experimental::properties{
+        sycl::ext::intel::experimental::buffer_location<BL>,
+        sycl::ext::intel::experimental::dwidth<BusWidth>,
+        sycl::ext::intel::experimental::maxburst<MaxBurst>,
+        sycl::ext::intel::experimental::latency<0>,
+        sycl::ext::intel::experimental::read_write_mode_write,
+        sycl::ext::oneapi::experimental::alignment<BusWidth / 8>});
+
+using BurstLSU = sycl::ext::intel::lsu<
+    sycl::ext::intel::burst_coalesce<true>,       // agrégation en bursts
+    sycl::ext::intel::statically_coalesce<true>>;
+
+template <typename P>
+inline auto toGlobal(P* p) {
+  return sycl::address_space_cast<sycl::access::address_space::global_space,
+                                   sycl::access::decorated::no>(p);
+}
+
+// -----------------------------------------------------------------------------
+// Transposition mémoire -> mémoire par tuiles
+//   in  : matrice rows × cols (row-major)
+//   out : matrice cols × rows (row-major)
+// Ping-pong : pendant que la tuile k est lue dans buffer[k % NumBuffers], la
+// tuile k-1 est écrite transposée depuis buffer[(k-1) % NumBuffers]. Les deux
+// ports travaillent donc en même temps, kPerBeat éléments par cycle chacun.
+// rows et cols sont quelconques : les tuiles de bord sont traitées avec des
+// accès masqués, les adresses sont calculées sur 64 bits.
+// Mode batch : frames trames espacées de stride éléments (0 = rows × cols)
+// sont traitées à la suite dans la même boucle, le ping-pong reste plein
+// d'une trame à l'autre.
+// Sous-matrice : offIn / offOut décalent le début de la lecture / de
+// l'écriture (éléments) et ldOut fixe la longueur d'une ligne de sortie
+// (0 = rows), pour transposer une sous-matrice d'une trame plus grande.
+// Perf : busy = itérations de la boucle interne, tiles = tuiles transposées ;
+// sans pipe, tout le reste des cycles est de l'attente load / store.
+// -----------------------------------------------------------------------------
+template <typename T,
+          int TileRows = ElemTraits<T>::kTileRows,
+          int TileCols = ElemTraits<T>::kTileCols,
+          int NumBuffers = ElemTraits<T>::kNumBuffers,
+          int BusWidth = 512,
+          int BlIn = 1, int BlOut = 2,
+          typename Perf = NoPerf>
+struct Transpose {
+  static constexpr int kPerBeat = BusWidth / ElemTraits<T>::kBits;
+  static constexpr int kBankBytes = BusWidth / 8;
+  static constexpr int kBeatsLoadRow = TileCols / kPerBeat;  // battements par ligne lue
+  static constexpr int kBeatsStoreRow = TileRows / kPerBeat; // battements par ligne écrite
+  static constexpr int kSteps = TileRows * kBeatsLoadRow;    // battements par tuile
+  static_assert(kPerBeat >= 1, "BusWidth plus petit qu'un élément");
+  static_assert(TileRows % kPerBeat == 0, "TileRows doit être un multiple de BusWidth / kBits");
+  static_assert(TileCols % kPerBeat == 0, "TileCols doit être un multiple de BusWidth / kBits");
+  static_assert(NumBuffers >= 2, "le ping-pong demande au moins 2 buffers");
+
+  sycl::ext::oneapi::experimental::annotated_arg<T*, InProps<BlIn, BusWidth>> in;
+  sycl::ext::oneapi::experimental::annotated_arg<T*, OutProps<BlOut, BusWidth>> out;
+  ConduitArg<uint32_t> rows; // ligne
+  ConduitArg<uint32_t> cols; // colonne
+  ConduitArg<uint32_t> frames{1}; // nombre de trames
+  ConduitArg<uint64_t> stride{0}; // écart entre trames (éléments)
+  ConduitArg<uint64_t> offIn{0};  // début de la lecture (éléments)
+  ConduitArg<uint64_t> offOut{0}; // début de l'écriture (éléments)
+  ConduitArg<uint32_t> ldOut{0};  // longueur d'une ligne de sortie (0 = rows)
+
+  [[intel::kernel_args_restrict]]
+  void operator()() const {
+    Perf::start();
+    const uint64_t n = tiles(in, out, offIn, offOut, rows, cols, frames, stride, ldOut);
+    Perf::stop(uint64_t(n + 1) * kSteps, 0, n);
+  }
+
+  // Corps du kernel, réutilisé par TransposeRing : offIn / offOut décalent
+  // la trame (en éléments) dans in / out. Renvoie le nombre de tuiles.
+  template <typename InArg, typename OutArg>
+  static uint64_t tiles(const InArg& in, const OutArg& out, uint64_t offIn, uint64_t offOut,
+                        uint32_t rowsArg, uint32_t colsArg, uint32_t frames, uint64_t stride,
+                        uint32_t ldOutArg = 0) {
+
+    // Écrit par ligne, relu par colonne : une seule copie, les accès sont
+    // arbitrés plutôt que les banques MLAB répliquées
+    [[intel::max_replicates(1),intel::fpga_memory("MLAB"),intel::bankwidth(kBankBytes)]]
+    T buffer[NumBuffers][TileRows][TileCols];
+
+    [[intel::fpga_register]] uint32_t ligne = rowsArg;
+    [[intel::fpga_register]] uint32_t colonne = colsArg;
+    [[intel::fpga_register]] uint32_t ld = ldOutArg == 0 ? rowsArg : ldOutArg;
+
+    // Tuiles de bord incluses : les accès hors matrice sont masqués.
+    // Nombre de tuiles sur 64 bits : nbPassH × nbPassV × frames dépasse 2^32
+    // pour les grandes matrices ou les gros batches.
+    uint32_t nbPassH = (colonne + TileCols - 1) / TileCols;
+    uint32_t nbPassV = (ligne + TileRows - 1) / TileRows;
+    uint64_t nbTuiles = uint64_t(nbPassH) * nbPassV * frames;
+    uint64_t pas = (stride == 0) ? uint64_t(ligne) * colonne : uint64_t(stride);
+
+    // Coordonnées (ligne, colonne de tuiles) et début de trame de la tuile
+    // lue et de la tuile écrite
+    uint32_t aL = 0, bL = 0;
+    uint32_t aS = 0, bS = 0;
+    uint64_t baseL = 0, baseS = 0;
+
+    // Une itération de plus pour vider le dernier buffer.
+    // Pas d'ivdep ici : l'itération k + 1 relit transposée la tuile que
+    // l'itération k vient d'écrire, le compilateur doit garder cet ordre.
+    for (uint64_t k = 0; k <= nbTuiles; k++) {
+      const bool lire = k < nbTuiles;
+      const bool ecrire = k > 0;
+      const uint32_t idL = k % NumBuffers;
+      const uint32_t idS = (k + NumBuffers - 1) % NumBuffers;
+
+      [[intel::initiation_interval(1),intel::ivdep(buffer)]]
+      for (uint32_t s = 0; s < kSteps; s++) {
+        // Lecture : ligne iL de la tuile k, éléments jL .. jL + kPerBeat
+        const uint32_t iL = s / kBeatsLoadRow;
+        const uint32_t jL = (s % kBeatsLoadRow) * kPerBeat;
+        #pragma unroll
+        for (uint32_t l = 0; l < kPerBeat; l++) {
+          uint32_t r = aL * TileRows + iL;
+          uint32_t c = bL * TileCols + jL + l;
+          if (lire && r < ligne && c < colonne)
+            buffer[idL][iL][jL + l] = BurstLSU::load(toGlobal(&in[offIn + baseL + size_t(r) * colonne + c]));
+        }
+
+        // Écriture : ligne iS de la tuile k-1 transposée
+        const uint32_t iS = s / kBeatsStoreRow;
+        const uint32_t jS = (s % kBeatsStoreRow) * kPerBeat;
+        #pragma unroll
+        for (uint32_t l = 0; l < kPerBeat; l++) {
+          uint32_t r = bS * TileCols + iS;     // ligne de sortie
+          uint32_t c = aS * TileRows + jS + l; // colonne de sortie
+          if (ecrire && r < colonne && c < ligne)
+            BurstLSU::store(toGlobal(&out[offOut + baseS + size_t(r) * ld + c]), buffer[idS][jS + l][iS]);
+        }
+      }
+
+      aS = aL;
+      bS = bL;
+      baseS = baseL;
+      if (++bL == nbPassH) {
+        bL = 0;
+        if (++aL == nbPassV) {
+          aL = 0;
+          baseL += pas;
+        }
+      }
+    }
+    return nbTuiles;
+  }
+};
+
+// -----------------------------------------------------------------------------
+// Transpose piloté par le Nios (transpose_drv.c) : in, out, rows et cols sont
+// des registres de la carte CSR et non des conduits, une trame par start.
+// Ordre des arguments = offsets TRANSPOSE_ARG_* de transpose_drv.h.
+// -----------------------------------------------------------------------------
+template <typename T,
+          int TileRows = ElemTraits<T>::kTileRows,
+          int TileCols = ElemTraits<T>::kTileCols,
+          int NumBuffers = ElemTraits<T>::kNumBuffers,
+          int BusWidth = 512,
+          int BlIn = 1, int BlOut = 2>
+struct TransposeCsr {
+  using Tiles = Transpose<T, TileRows, TileCols, NumBuffers, BusWidth, BlIn, BlOut>;
+
+  sycl::ext::oneapi::experimental::annotated_arg<T*, InProps<BlIn, BusWidth>> in;
+  sycl::ext::oneapi::experimental::annotated_arg<T*, OutProps<BlOut, BusWidth>> out;
+  uint32_t rows;
+  uint32_t cols;
+
+  [[intel::kernel_args_restrict]]
+  void operator()() const { Tiles::tiles(in, out, 0, 0, rows, cols, 1, 0); }
+};
+
+// -----------------------------------------------------------------------------
+// Anneau de descripteurs : un seul start pour count trames
+// Le Nios écrit des descripteurs TransposeDesc dans ring (RAM on-chip) puis
+// lance le kernel avec (first, count) ; le kernel traite ring[first],
+// ring[first + 1], ... (modulo ringSize) sans autre accès CSR. in / out des
+// descripteurs sont des décalages en octets par rapport aux arguments in /
+// out (in = out = 0 : adresses Avalon directes).
+// Fin de chaque descripteur : après les écritures de la trame, le kernel
+// recopie seq dans status ; l'IRQ done ne signale que la fin du lot.
+// Même disposition mémoire que transpose_desc_t (transpose_drv.h).
+// -----------------------------------------------------------------------------
+struct TransposeDesc {
+  uint64_t in;     // décalage de l'entrée (octets)
+  uint64_t out;    // décalage de la sortie (octets)
+  uint32_t rows;   // 0 : descripteur ignoré
+  uint32_t cols;
+  uint32_t seq;    // numéro écrit par l'hôte
+  uint32_t status; // = seq une fois la trame écrite
+};
+static_assert(sizeof(TransposeDesc) == 32, "disposition partagée avec le Nios");
+
+template <typename T,
+          int TileRows = ElemTraits<T>::kTileRows,
+          int TileCols = ElemTraits<T>::kTileCols,
+          int NumBuffers = ElemTraits<T>::kNumBuffers,
+          int BusWidth = 512,
+          int BlIn = 1, int BlOut = 2, int BlRing = 0>
+struct TransposeRing {
+  using Tiles = Transpose<T, TileRows, TileCols, NumBuffers, BusWidth, BlIn, BlOut>;
+
+  // Registres CSR, écrits par le Nios (pas de conduit)
+  sycl::ext::oneapi::experimental::annotated_arg<T*, InProps<BlIn, BusWidth>> in;
+  sycl::ext::oneapi::experimental::annotated_arg<T*, OutProps<BlOut, BusWidth>> out;
+  sycl::ext::oneapi::experimental::annotated_arg<
+      TransposeDesc*, decltype(sycl::ext::oneapi::experimental::properties{
+                          sycl::ext::intel::experimental::buffer_location<BlRing>,
+                          sycl::ext::intel::experimental::dwidth<64>,
+                          sycl::ext::intel::experimental::read_write_mode_readwrite})>
+      ring;
+  uint32_t ringSize;
+  uint32_t first;
+  uint32_t count;
+
+  [[intel::kernel_args_restrict]]
+  void operator()() const {
+    uint32_t idx = first;
+    for (uint32_t d = 0; d < count; d++) {
+      const TransposeDesc desc = ring[idx];
+      if (desc.rows != 0 && desc.cols != 0)
+        Tiles::tiles(in, out, desc.in / sizeof(T), desc.out / sizeof(T),
+                     desc.rows, desc.cols, 1, 0);
+
+      // La trame doit être en mémoire avant que le Nios ne voie status
+      sycl::atomic_fence(sycl::memory_order::seq_cst, sycl::memory_scope::device);
+      ring[idx].status = desc.seq;
+      if (++idx == ringSize)
+        idx = 0;
+    }
+  }
+};
+
+// -----------------------------------------------------------------------------
+// Transposition en place d'une matrice carrée n × n
+// Les tuiles (a, b) et (b, a), b >= a, sont lues dans deux buffers puis
+// réécrites transposées l'une à la place de l'autre : une seule allocation
+// de n × n éléments suffit. Les tuiles de bord sont masquées comme pour
+// Transpose.
+// -----------------------------------------------------------------------------
+template <int BL, int BusWidth>
+using InOutProps = decltype(
+    sycl::ext::oneapi::experimental::properties{
+        sycl::ext::intel::experimental::buffer_location<BL>,
+        sycl::ext::intel::experimental::dwidth<BusWidth>,
+        sycl::ext::intel::experimental::maxburst<4>,
+        sycl::ext::intel::experimental::latency<0>,
+        sycl::ext::intel::experimental::read_write_mode_readwrite,
+        sycl::ext::oneapi::experimental::alignment<BusWidth / 8>});
+
+template <typename T,
+          int Tile = ElemTraits<T>::kTileRows,
+          int BusWidth = 512,
+          int Bl = 1>
+struct TransposeInPlace {
+  static constexpr int kPerBeat = BusWidth / ElemTraits<T>::kBits;
+  static constexpr int kBankBytes = BusWidth / 8;
+  static constexpr int kBeatsRow = Tile / kPerBeat;
+  static constexpr int kSteps = Tile * kBeatsRow;
+  static_assert(kPerBeat >= 1, "BusWidth plus petit qu'un élément");
+  static_assert(Tile % kPerBeat == 0, "Tile doit être un multiple de BusWidth / kBits");
+
+  sycl::ext::oneapi::experimental::annotated_arg<T*, InOutProps<Bl, BusWidth>> data;
+  ConduitArg<uint32_t> n; // côté de la matrice
+
+  void operator()() const {
+
+    [[intel::fpga_memory("MLAB"),intel::bankwidth(kBankBytes)]] T bufA[Tile][Tile];
+    [[intel::fpga_memory("MLAB"),intel::bankwidth(kBankBytes)]] T bufB[Tile][Tile];
+
+    [[intel::fpga_register]] uint32_t cote = n;
+    const uint32_t nbT = (cote + Tile - 1) / Tile;
+
+    [[intel::loop_coalesce(2)]]
+    for (uint32_t a = 0; a < nbT; a++) {
+      for (uint32_t b = a; b < nbT; b++) {
+        const bool diag = (a == b);
+
+        // Lecture des tuiles A = (a, b) et B = (b, a)
+        [[intel::initiation_interval(1)]]
+        for (uint32_t s = 0; s < kSteps; s++) {
+          const uint32_t i = s / kBeatsRow;
+          const uint32_t j = (s % kBeatsRow) * kPerBeat;
+          #pragma unroll
+          for (uint32_t l = 0; l < kPerBeat; l++) {
+            const uint32_t rA = a * Tile + i, cA = b * Tile + j + l;
+            const uint32_t rB = b * Tile + i, cB = a * Tile + j + l;
+            if (rA < cote && cA < cote)
+              bufA[i][j + l] = BurstLSU::load(toGlobal(&data[size_t(rA) * cote + cA]));
+            if (!diag && rB < cote && cB < cote)
+              bufB[i][j + l] = BurstLSU::load(toGlobal(&data[size_t(rB) * cote + cB]));
+          }
+        }
+
+        // Écriture : A transposée en (b, a), B transposée en (a, b)
+        [[intel::initiation_interval(1)]]
+        for (uint32_t s = 0; s < kSteps; s++) {
+          const uint32_t i = s / kBeatsRow;
+          const uint32_t j = (s % kBeatsRow) * kPerBeat;
+          #pragma unroll
+          for (uint32_t l = 0; l < kPerBeat; l++) {
+            const uint32_t rA = b * Tile + i, cA = a * Tile + j + l;
+            const uint32_t rB = a * Tile + i, cB = b * Tile + j + l;
+            if (rA < cote && cA < cote)
+              BurstLSU::store(toGlobal(&data[size_t(rA) * cote + cA]), bufA[j + l][i]);
+            if (!diag && rB < cote && cB < cote)
+              BurstLSU::store(toGlobal(&data[size_t(rB) * cote + cB]), bufB[j + l][i]);
+          }
+        }
+      }
+    }
+  }
+};
+
+// Enfile la transposition de frames trames (écart stride, 0 = contiguës) en
+// un seul lancement, sans attendre ; les dépendances éventuelles sont
+// passées dans deps.
+template <typename KernelName, typename TransposeT, typename T>
+sycl::event enqueueTranspose(sycl::queue& q, T* in, T* out,
+                             uint32_t rows, uint32_t cols,
+                             uint32_t frames = 1, uint64_t stride = 0,
+                             const std::vector<sycl::event>& deps = {}) {
+  return q.submit([&](sycl::handler& h) {
+    h.depends_on(deps);
+    h.single_task<KernelName>(TransposeT{in, out, rows, cols, frames, stride});
+  });
+}
+
+// Transposition avec repli CPU : tant que le lancement FPGA précédent n'est
+// pas terminé, les demandes suivantes sont traitées par cpu::transpose (in et
+// out doivent alors être accessibles depuis l'hôte, p. ex. malloc_shared).
+// Même interface que enqueueTranspose ; l'évènement renvoyé est vide quand
+// le calcul a été fait sur CPU.
+template <typename KernelName, typename TransposeT>
+struct TransposeFallback {
+  sycl::event enCours;
+  uint64_t nbFpga = 0;
+  uint64_t nbCpu = 0;
+
+  bool fpgaOccupe() const {
+    return enCours.get_info<sycl::info::event::command_execution_status>() !=
+           sycl::info::event_command_status::complete;
+  }
+
+  template <typename T>
+  sycl::event run(sycl::queue& q, T* in, T* out, uint32_t rows, uint32_t cols,
+                  uint32_t frames = 1, uint64_t stride = 0) {
+    if (fpgaOccupe()) {
+      cpu::transpose(in, out, rows, cols, frames, stride);
+      nbCpu++;
+      return sycl::event{};
+    }
+    enCours = enqueueTranspose<KernelName, TransposeT>(q, in, out, rows, cols, frames, stride);
+    nbFpga++;
+    return enCours;
+  }
+};
+
+// -----------------------------------------------------------------------------
+// Mode multi compute-unit (côté hôte)
+// La trame est découpée en NumCU bandes de lignes de tuiles ; la bande k est
+// transposée par sa propre instance de Transpose, qui lit dans la banque
+// inBank(k) = BlBase + k % NumBanks et écrit dans outBank(k) = BlBase +
+// (k + 1) % NumBanks : chaque banque a au plus un lecteur et un écrivain, le
+// débit cumulé suit le nombre de banques sans compter sur l'entrelacement
+// d'adresses du BSP.
+// La trame vit donc par bandes, chacune dans sa banque, sans copie :
+//   bandes[k].in  : lignes r0_k .. r0_k + h_k de la trame (h_k × cols)
+//   bandes[k].out : colonnes r0_k .. r0_k + h_k de la transposée (cols × h_k)
+// Le producteur écrit directement dans in(r, c) et le consommateur lit
+// out(r, c) ; alloc() réserve les bandes une fois pour toutes les trames.
+// -----------------------------------------------------------------------------
+template <typename MultiCU, int K> class TransposeCuKernel;
+
+template <typename T, int NumCU,
+          int NumBanks = NumCU,
+          int BlBase = 1,
+          int TileRows = ElemTraits<T>::kTileRows,
+          int TileCols = ElemTraits<T>::kTileCols,
+          int NumBuffers = ElemTraits<T>::kNumBuffers,
+          int BusWidth = 512>
+struct TransposeMultiCU {
+  static constexpr int inBank(int k) { return BlBase + k % NumBanks; }
+  static constexpr int outBank(int k) { return BlBase + (k + 1) % NumBanks; }
+
+  template <int K>
+  using Cu = Transpose<T, TileRows, TileCols, NumBuffers, BusWidth, inBank(K), outBank(K)>;
+
+  struct Bande {
+    T* in;       // h × cols, banque inBank(k)
+    T* out;      // cols × h, banque outBank(k)
+    uint32_t r0; // première ligne de la bande dans la trame
+    uint32_t h;  // nombre de lignes de la bande
+  };
+
+  Bande bandes[NumCU];
+  uint32_t rows = 0;
+  uint32_t cols = 0;
+
+  // Répartit les lignes de tuiles le plus équitablement possible et alloue
+  // les bandes de chaque instance dans leurs banques
+  void alloc(sycl::queue& q, uint32_t nbRows, uint32_t nbCols) {
+    rows = nbRows;
+    cols = nbCols;
+    const uint32_t nbTuiles = (rows + TileRows - 1) / TileRows;
+    uint32_t t0 = 0;
+    for (int k = 0; k < NumCU; k++) {
+      const uint32_t nt = nbTuiles / NumCU + (uint32_t(k) < nbTuiles % NumCU ? 1 : 0);
+      const uint32_t r0 = std::min(rows, t0 * TileRows);
+      const uint32_t r1 = std::min(rows, (t0 + nt) * TileRows);
+      bandes[k].r0 = r0;
+      bandes[k].h = r1 - r0;
+      t0 += nt;
+    }
+    allocAll(q, std::make_integer_sequence<int, NumCU>{});
+  }
+
+  // Élément (r, c) de la trame / de la transposée, dans sa bande
+  T& in(uint32_t r, uint32_t c) {
+    const Bande& b = bandes[bandeDe(r)];
+    return b.in[size_t(r - b.r0) * cols + c];
+  }
+  const T& out(uint32_t r, uint32_t c) const {
+    const Bande& b = bandes[bandeDe(c)];
+    return b.out[size_t(r) * b.h + (c - b.r0)];
+  }
+
+  // Lance les NumCU kernels sans attendre
+  std::vector<sycl::event> launch(sycl::queue& q) {
+    std::vector<sycl::event> ev;
+    launchAll(q, ev, std::make_integer_sequence<int, NumCU>{});
+    return ev;
+  }
+
+  void free(sycl::queue& q) {
+    for (auto& b : bandes) {
+      sycl::free(b.in, q);
+      sycl::free(b.out, q);
+    }
+  }
+
+private:
+  // Bande contenant la ligne r de la trame : les bandes sont contiguës
+  uint32_t bandeDe(uint32_t r) const {
+    int k = NumCU - 1;
+    while (k > 0 && r < bandes[k].r0)
+      k--;
+    return uint32_t(k);
+  }
+
+  template <int... K>
+  void allocAll(sycl::queue& q, std::integer_sequence<int, K...>) {
+    // Au moins un élément : une bande vide garde un pointeur valide
+    ((bandes[K].in = sycl::malloc_shared<T>(
+          std::max<size_t>(1, size_t(bandes[K].h) * cols), q,
+          {sycl::ext::intel::experimental::property::usm::buffer_location(inBank(K))}),
+      bandes[K].out = sycl::malloc_shared<T>(
+          std::max<size_t>(1, size_t(bandes[K].h) * cols), q,
+          {sycl::ext::intel::experimental::property::usm::buffer_location(outBank(K))})),
+     ...);
+  }
+
+  template <int... K>
+  void launchAll(sycl::queue& q, std::vector<sycl::event>& ev,
+                 std::integer_sequence<int, K...>) {
+    (ev.push_back(q.single_task<TransposeCuKernel<TransposeMultiCU, K>>(
+         Cu<K>{bandes[K].in, bandes[K].out, bandes[K].h, cols})), ...);
+  }
+};
+
+// Battement d'entrée multi-voies : Lanes échantillons consécutifs d'une ligne
+template <typename T, int Lanes> struct WideBeat {
+  T v[Lanes];
+};
+
+// -----------------------------------------------------------------------------
+// Transposition pipe -> mémoire (ex transpose_finale.cpp)
+// Le flux arrive ligne par ligne, Lanes échantillons par lecture du pipe ;
+// on accumule StripeRows lignes dans un double buffer déjà transposé, et on
+// écrit la bande de StripeRows colonnes de la sortie pendant la réception de
+// la bande suivante : dans la même boucle, la bande a est reçue dans
+// buffer[a % 2] pendant que la bande a-1 est écrite depuis l'autre moitié.
+// La réception (StripeRows × cols / Lanes itérations) couvre l'écriture (cols
+// itérations) dès que StripeRows >= Lanes : en régime établi, un battement
+// de pipe par cycle, à l'entrée de boucle près à chaque bande.
+// Le buffer est rangé [2][MaxCols / Lanes][Lanes][StripeRows] avec une banque
+// par voie : les Lanes écritures d'un battement tombent dans des banques
+// différentes et chaque lecture de StripeRows éléments est un seul mot de
+// banque, d'où II=1 des deux côtés.
+// Tailles : rows quelconque, la dernière bande peut être partielle (ses
+// écritures sont masquées) ; cols multiple de Lanes et <= MaxCols, chaque
+// ligne arrivant en cols / Lanes battements pleins. accepte() le vérifie
+// côté hôte, avant le lancement.
+// Perf : la réception passe en lectures non bloquantes pour compter les
+// itérations sur pipe vide ; busy = les autres itérations, tiles = bandes
+// écrites. Le reste des cycles est l'attente du LSU de sortie.
+// -----------------------------------------------------------------------------
+template <typename Pipe, typename T,
+          int StripeRows = 32,
+          int MaxCols = 2048,
+          int BusWidth = 512,
+          int BlOut = 1,
+          int Lanes = 1,
+          typename Perf = NoPerf>
+struct TransposeStream {
+  static_assert((Lanes & (Lanes - 1)) == 0, "Lanes doit être une puissance de 2");
+  static_assert(MaxCols % Lanes == 0, "MaxCols doit être un multiple de Lanes");
+
+  sycl::ext::oneapi::experimental::annotated_arg<T*, OutProps<BlOut, BusWidth, 8>> out;
+  ConduitArg<uint32_t> rows; // ligne (quelconque)
+  ConduitArg<uint32_t> cols; // colonne (<= MaxCols, multiple de Lanes)
+
+  // Côté hôte : cols que le kernel sait recevoir, à vérifier avant lancement
+  static bool accepte(uint32_t nbRows, uint32_t nbCols) {
+    return nbRows > 0 && nbCols > 0 && nbCols <= uint32_t(MaxCols) && nbCols % Lanes == 0;
+  }
+
+  [[intel::kernel_args_restrict]]
+  void operator()() const {
+
+    [[intel::numbanks(Lanes),intel::bankwidth(StripeRows * sizeof(T)),intel::max_replicates(1)]]
+    T buffer[2][MaxCols / Lanes][Lanes][StripeRows];
+
+    [[intel::fpga_register]] size_t ligne = rows;
+    [[intel::fpga_register]] size_t colonne = cols;
+
+    // Bandes entières plus la dernière, partielle
+    [[intel::fpga_register]] size_t nbPass = (ligne + StripeRows - 1) / StripeRows;
+    [[intel::fpga_register]] size_t nbBeats = colonne / Lanes;
+    size_t hS = 0; // hauteur de la bande a-1, en cours d'écriture
+
+    uint64_t iterations = 0, attente = 0; // Perf
+    Perf::start();
+
+    // Une itération de plus pour écrire la dernière bande
+    [[intel::ivdep(buffer)]]
+    for (size_t a = 0; a <= nbPass; a++) {
+      const size_t hL = a < nbPass ? std::min<size_t>(StripeRows, ligne - StripeRows * a) : 0;
+      const size_t nS = a > 0 ? colonne : 0;
+      const size_t baseS = StripeRows * (a - 1); // première colonne de sortie
+
+      size_t i = 0, jb = 0; // réception : ligne i de la bande, battement jb
+      size_t j = 0;         // écriture : ligne de sortie j
+
+      [[intel::initiation_interval(1),intel::ivdep(buffer)]]
+      while (i < hL || j < nS) {
+        if (i < hL) {
+          bool ok = true;
+          WideBeat<T, Lanes> beat;
+          if constexpr (Perf::kOn)
+            beat = Pipe::read(ok);
+          else
+            beat = Pipe::read();
+          if (ok) {
+            #pragma unroll
+            for (int l = 0; l < Lanes; l++)
+              buffer[a % 2][jb][l][i] = beat.v[l];
+            if (++jb == nbBeats) {
+              jb = 0;
+              i++;
+            }
+          } else {
+            attente++;
+          }
+        }
+
+        if (j < nS) {
+          #pragma unroll
+          for (size_t r = 0; r < StripeRows; r++) {
+            if (r < hS)
+              BurstLSU::store(toGlobal(out + j * ligne + baseS + r),
+                              buffer[(a + 1) % 2][j / Lanes][j % Lanes][r]);
+          }
+          j++;
+        }
+        if constexpr (Perf::kOn)
+          iterations++;
+      }
+      hS = hL;
+    }
+
+    Perf::stop(iterations - attente, attente, nbPass);
+  }
+};
+
+// -----------------------------------------------------------------------------
+// Réordonnancement pipe -> pipe par bandes (sans aller-retour DDR)
+// Ce n'est PAS la transposée en row-major dès que rows > StripeRows : chaque
+// ligne de sortie arrive en morceaux de StripeRows éléments, entrelacés
+// d'une bande à l'autre. L'aval doit connaître cet ordre (ou écrire en
+// mémoire à out[j][a * StripeRows + i], comme TransposeStream) ; pour un flux
+// de vraies lignes transposées, voir TransposePipeFrame.
+// Même mémoire de réordonnancement [2][MaxCols][StripeRows] que
+// TransposeStream : pendant que la bande a est reçue dans buffer[a % 2], la
+// bande a-1 est émise depuis l'autre moitié.
+// Ordre d'émission : bande par bande, puis ligne de sortie j, puis les
+// StripeRows éléments consécutifs de cette ligne, c.-à-d. pour la bande a :
+//   out[j][a * StripeRows + i], j < cols, i < hauteur de la bande
+// La dernière bande peut être partielle si rows n'est pas multiple de
+// StripeRows. sof / eof marquent le premier et le dernier élément de la trame.
+// -----------------------------------------------------------------------------
+template <typename T> struct StreamBeat {
+  T data;
+  bool sof; // début de trame
+  bool eof; // fin de trame
+};
+
+template <typename InPipe, typename OutPipe, typename T,
+          int StripeRows = 32,
+          int MaxCols = 2048>
+struct TransposePipe {
+  ConduitArg<uint32_t> rows; // ligne
+  ConduitArg<uint32_t> cols; // colonne (<= MaxCols)
+
+  void operator()() const {
+
+    [[intel::numbanks(2),intel::max_replicates(1)]] T buffer[2][MaxCols][StripeRows];
+
+    [[intel::fpga_register]] uint32_t ligne = rows;
+    [[intel::fpga_register]] uint32_t colonne = cols;
+
+    const uint32_t nbPass = (ligne + StripeRows - 1) / StripeRows;
+    const uint32_t total = ligne * colonne;
+
+    uint32_t emis = 0;
+    uint32_t hS = 0; // hauteur de la bande en cours d'émission
+
+    // Une itération de plus pour émettre la dernière bande
+    [[intel::ivdep(buffer)]]
+    for (uint32_t a = 0; a <= nbPass; a++) {
+      const uint32_t reste = ligne - a * StripeRows;
+      const uint32_t hL = (a < nbPass) ? (reste < StripeRows ? reste : StripeRows) : 0;
+      const uint32_t nL = hL * colonne;
+      const uint32_t nS = hS * colonne;
+      const uint32_t n = nL > nS ? nL : nS;
+
+      uint32_t iL = 0, jL = 0; // réception : ligne iL, colonne jL de la bande a
+      uint32_t jS = 0, iS = 0; // émission : ligne de sortie jS, élément iS
+
+      [[intel::initiation_interval(1),intel::ivdep(buffer)]]
+      for (uint32_t t = 0; t < n; t++) {
+        if (t < nL) {
+          buffer[a % 2][jL][iL] = InPipe::read();
+          if (++jL == colonne) {
+            jL = 0;
+            iL++;
+          }
+        }
+        if (t < nS) {
+          emis++;
+          OutPipe::write(StreamBeat<T>{buffer[(a + 1) % 2][jS][iS], emis == 1, emis == total});
+          if (++iS == hS) {
+            iS = 0;
+            jS++;
+          }
+        }
+      }
+      hS = hL;
+    }
+  }
+};
+
+// -----------------------------------------------------------------------------
+// Transposition pipe -> pipe d'une trame entière
+// La trame rows × cols (rows <= MaxRows, cols <= MaxCols) est reçue ligne par
+// ligne dans buffer[f % 2], puis émise transposée en row-major : ligne de
+// sortie j = colonne j de l'entrée, ses rows éléments à la suite. Avec
+// frames > 1, la trame f est reçue pendant que la trame f-1 est émise.
+// Coût : 2 × MaxRows × MaxCols éléments on-chip, à réserver aux petites
+// trames ; au-delà, TransposeStream et un passage en mémoire.
+// sof / eof marquent le premier et le dernier élément de chaque trame.
+// -----------------------------------------------------------------------------
+template <typename InPipe, typename OutPipe, typename T,
+          int MaxRows = 64,
+          int MaxCols = 64>
+struct TransposePipeFrame {
+  ConduitArg<uint32_t> rows;      // <= MaxRows
+  ConduitArg<uint32_t> cols;      // <= MaxCols
+  ConduitArg<uint32_t> frames{1};
+
+  void operator()() const {
+
+    [[intel::numbanks(2),intel::max_replicates(1)]] T buffer[2][MaxCols][MaxRows];
+
+    [[intel::fpga_register]] uint32_t ligne = rows;
+    [[intel::fpga_register]] uint32_t colonne = cols;
+    const uint32_t n = ligne * colonne;
+
+    // Une itération de plus pour émettre la dernière trame
+    [[intel::ivdep(buffer)]]
+    for (uint32_t f = 0; f <= frames; f++) {
+      const uint32_t nL = f < frames ? n : 0;
+      const uint32_t nS = f > 0 ? n : 0;
+
+      uint32_t iL = 0, jL = 0; // réception : ligne iL, colonne jL
+      uint32_t jS = 0, iS = 0; // émission : ligne de sortie jS, élément iS
+
+      [[intel::initiation_interval(1),intel::ivdep(buffer)]]
+      for (uint32_t t = 0; t < n; t++) {
+        if (t < nL) {
+          buffer[f % 2][jL][iL] = InPipe::read();
+          if (++jL == colonne) {
+            jL = 0;
+            iL++;
+          }
+        }
+        if (t < nS) {
+          OutPipe::write(StreamBeat<T>{buffer[(f + 1) % 2][jS][iS], t == 0, t == n - 1});
+          if (++iS == ligne) {
+            iS = 0;
+            jS++;
+          }
+        }
+      }
+    }
+  }
+};
+
+} // namespace fpga_tools
+
+#endif //__TRANSPOSE_HPP__
@@ -1,133 +1,148 @@
 #include <sycl/ext/intel/fpga_extensions.hpp>
 #include <sycl/sycl.hpp>
 #include "exception_handler.hpp"
-#include <sycl/ext/intel/ac_types/ac_complex.hpp>
+#include "transpose.hpp"
 
 #include <algorithm>
-
-constexpr uint16_t nbBuffer = 4 ;
+#include <cstring>
+#include <string>
+#include <vector>
 
 constexpr int Kbl1 = 1;
 constexpr int Kbl2 = 2;
-constexpr uint16_t tTuile = 32 ;
-
-class TransposeKernel;
-class IdPipeA;
-
-// Propriétés du pipe inchangées
-using pipe_props = decltype(
-    sycl::ext::oneapi::experimental::properties(
-        sycl::ext::intel::experimental::ready_latency<0>));
-
-using Complex   = ac_complex<float>;
-
-/* using InputPipe = sycl::ext::intel::experimental::pipe<
-    IdPipeA, Complex, 0, pipe_props>; */
-
-// Propriétés pour l'annotation de l'input
-using in_props = decltype(
-  sycl::ext::oneapi::experimental::properties{
-      sycl::ext::intel::experimental::buffer_location<Kbl1>,
-      sycl::ext::intel::experimental::dwidth<512>, //512
-      sycl::ext::intel::experimental::maxburst<4>, // 4
-      sycl::ext::intel::experimental::latency<0>,
-      sycl::ext::intel::experimental::read_write_mode_read,
-      // un Complex fait 2×32 bits = 64 bits = 8 octets d'alignement
-      sycl::ext::oneapi::experimental::alignment<64>}); //64
-
-// Propriétés pour l'annotation de l'output
-using out_props = decltype(
-    sycl::ext::oneapi::experimental::properties{
-        sycl::ext::intel::experimental::buffer_location<Kbl2>,
-        sycl::ext::intel::experimental::dwidth<512>, //512
-        sycl::ext::intel::experimental::maxburst<4>, // 4
-        sycl::ext::intel::experimental::latency<0>,
-        sycl::ext::intel::experimental::read_write_mode_write,
-        // un Complex fait 2×32 bits = 64 bits = 8 octets d'alignement
-        sycl::ext::oneapi::experimental::alignment<64>}); //64
-
-using LSU512 = sycl::ext::intel::lsu<
-  sycl::ext::intel::burst_coalesce<true>,      // agrégation en bursts
-  sycl::ext::intel::statically_coalesce<true>>;// on garde l’analyse simple
-
-using LoadLSU = sycl::ext::intel::lsu<
-    sycl::ext::intel::burst_coalesce<true>,          
-    sycl::ext::intel::statically_coalesce<true>
->;
-
-struct Transpose {
-// in pointe maintenant sur un tableau de Complex
-  sycl::ext::oneapi::experimental::annotated_arg<
-  Complex*,
-      in_props>
-      in;
-  // out pointe maintenant sur un tableau de Complex
-  sycl::ext::oneapi::experimental::annotated_arg<
-  Complex*,
-      out_props>
-      out;
-  sycl::ext::oneapi::experimental::annotated_arg<
-      uint32_t,
-      decltype(sycl::ext::oneapi::experimental::properties{
-          sycl::ext::intel::experimental::conduit})>
-      rows; // ligne
-  sycl::ext::oneapi::experimental::annotated_arg<
-      uint32_t,
-      decltype(sycl::ext::oneapi::experimental::properties{
-          sycl::ext::intel::experimental::conduit})>
-      cols; // colonne
-
-      [[intel::kernel_args_restrict]]
-      void operator()() const {
-  
-        [[intel::max_replicates(1),intel::fpga_memory("MLAB"),intel::bankwidth(64)]]Complex buffer[nbBuffer][tTuile][tTuile];
-  
-        [[intel::fpga_register]]   uint16_t ligne = rows ;
-        [[intel::fpga_register]] uint16_t colonne = cols ; // ça sera 2048 au max , ça changera pas
-  
-        uint8_t nbPassH = colonne / tTuile ;
-        uint8_t nbPassV = ligne / tTuile ;
-  
-        uint8_t idBuffer = 0 ;
-  
-        [[intel::loop_coalesce(2),intel::ivdep(buffer),intel::max_concurrency(4)]]
-        for (uint8_t a = 0 ; a < nbPassV  ; a++ ) {
-          [[intel::ivdep(buffer)]]
-          for (uint8_t b = 0 ; b < nbPassH ; b++ ) {
-  
-            idBuffer++;
-            
-            [[intel::loop_coalesce(2)]]
-            for (uint16_t i = 0; i < tTuile; i++) {
-              #pragma unroll 
-              for (uint16_t j = 0; j < tTuile; j++) {
-                uint16_t r = a * tTuile + i;
-                uint16_t c = b * tTuile + j;
-                
-                auto gptr = sycl::address_space_cast<
-                sycl::access::address_space::global_space,
-                sycl::access::decorated::no>(&in[r*colonne + c]);
-                buffer[ idBuffer % nbBuffer ][i][j] = LoadLSU::load(gptr);
-              }
-            }
-            
-            [[intel::loop_coalesce(2)]]
-            for (uint16_t i = 0; i < tTuile; i++) {
-              #pragma unroll (8)  
-              for (uint16_t j = 0; j < tTuile; j++) {
-                LSU512::store( sycl::address_space_cast<
-                  sycl::access::address_space::global_space,
-                  sycl::access::decorated::no>(&out[(b * tTuile + i) * ligne + (a * tTuile + j)]), buffer[idBuffer  % nbBuffer ][j][i]);
-              }
-            }
-            
-          }
-          
-      }
-  
-          
-    }  
-};
+
+template <typename T> class TransposeKernel;
+template <typename T> class PerfTimerKernel;
+template <typename T> class PerfId;
+
+// Fréquence du kernel pour convertir le temps mesuré en cycles
+// (à ajuster selon le fmax du rapport de synthèse)
+constexpr double kFmaxMHz = 300.0;
+
+// Configuration retenue par type : celle par défaut de ElemTraits<T>
+// (compteurs de performance avec -DPERF_COUNTERS=1)
+template <typename T>
+using TransposeMM = fpga_tools::Transpose<
+    T,
+    fpga_tools::ElemTraits<T>::kTileRows,
+    fpga_tools::ElemTraits<T>::kTileCols,
+    fpga_tools::ElemTraits<T>::kNumBuffers,
+    512, Kbl1, Kbl2,
+    fpga_tools::PerfSel<PerfId<T>>>;
+
+// Lance une transposition rows × cols de type T et vérifie le résultat
+template <typename T>
+bool testTranspose(sycl::queue& q, uint32_t rows, uint32_t cols, const char* nom) {
+  using Traits = fpga_tools::ElemTraits<T>;
+  const size_t elements = size_t(rows) * cols;
+
+  T* a = sycl::malloc_shared<T>(
+    elements, q,
+    {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl1)});
+
+  T* b = sycl::malloc_shared<T>(
+    elements, q,
+    {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl2)});
+
+  for (uint32_t r = 0; r < rows; ++r)
+    for (uint32_t c = 0; c < cols; ++c)
+      a[size_t(r) * cols + c] = Traits::make(r * cols + c);
+
+#if PERF_COUNTERS
+  auto* perf = sycl::malloc_shared<fpga_tools::PerfCounters>(1, q);
+  q.single_task<PerfTimerKernel<T>>(fpga_tools::PerfTimer<PerfId<T>>{perf});
+#endif
+
+  // Lancement du kernel
+  sycl::event e = q.single_task<TransposeKernel<T>>(TransposeMM<T>{a, b, rows, cols});
+  q.wait();
+
+  // Mesure : temps kernel (profiling) -> cycles par élément
+  const double ns =
+      e.get_profiling_info<sycl::info::event_profiling::command_end>() -
+      e.get_profiling_info<sycl::info::event_profiling::command_start>();
+  const double cycles = ns * kFmaxMHz / 1000.0;
+
+  // Vérification contre le backend CPU (bit à bit)
+  std::vector<T> ref(elements);
+  fpga_tools::cpu::transpose(a, ref.data(), rows, cols);
+  bool ok = std::memcmp(b, ref.data(), elements * sizeof(T)) == 0;
+
+  std::cout << nom << " : " << (ok ? "PASSED" : "FAILED")
+            << "  " << ns / 1000.0 << " us, "
+            << cycles / elements << " cycles/élément @ " << kFmaxMHz << " MHz\n";
+#if PERF_COUNTERS
+  // Lecture et écriture de chaque élément
+  fpga_tools::printPerf(std::cout, nom, *perf, elements, 2 * elements * sizeof(T), kFmaxMHz);
+  sycl::free(perf, q);
+#endif
+
+  sycl::free(a, q);
+  sycl::free(b, q);
+  return ok;
+}
+
+// Transpose nbBatch × frames trames rows × cols : un lancement par batch,
+// tous les batches enfilés avant un unique wait
+template <typename T>
+bool testBatch(sycl::queue& q, uint32_t rows, uint32_t cols,
+               uint32_t frames, uint32_t nbBatch, const char* nom) {
+  using Traits = fpga_tools::ElemTraits<T>;
+  const size_t elemFrame = size_t(rows) * cols;
+  const size_t elements = elemFrame * frames * nbBatch;
+
+  T* a = sycl::malloc_shared<T>(
+    elements, q,
+    {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl1)});
+
+  T* b = sycl::malloc_shared<T>(
+    elements, q,
+    {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl2)});
+
+  for (size_t i = 0; i < elements; ++i)
+    a[i] = Traits::make(uint32_t(i));
+
+#if PERF_COUNTERS
+  // Un seul compteur pour les nbBatch lancements, une entrée chacun
+  auto* perf = sycl::malloc_shared<fpga_tools::PerfCounters>(nbBatch, q);
+  q.single_task<PerfTimerKernel<T>>(fpga_tools::PerfTimer<PerfId<T>>{perf, nbBatch});
+#endif
+
+  std::vector<sycl::event> ev;
+  for (uint32_t k = 0; k < nbBatch; ++k) {
+    const size_t off = elemFrame * frames * k;
+    ev.push_back(fpga_tools::enqueueTranspose<TransposeKernel<T>, TransposeMM<T>>(
+        q, a + off, b + off, rows, cols, frames));
+  }
+  q.wait();
+
+  uint64_t debut = UINT64_MAX, fin = 0;
+  for (auto& e : ev) {
+    debut = std::min(debut, e.get_profiling_info<sycl::info::event_profiling::command_start>());
+    fin = std::max(fin, e.get_profiling_info<sycl::info::event_profiling::command_end>());
+  }
+  const double ns = double(fin - debut);
+
+  std::vector<T> ref(elements);
+  fpga_tools::cpu::transpose(a, ref.data(), rows, cols, frames * nbBatch);
+  bool ok = std::memcmp(b, ref.data(), elements * sizeof(T)) == 0;
+
+  std::cout << nom << " : " << (ok ? "PASSED" : "FAILED")
+            << "  " << frames * nbBatch * 1e9 / ns << " trames/s, "
+            << ns * kFmaxMHz / 1000.0 / elements << " cycles/élément\n";
+#if PERF_COUNTERS
+  for (uint32_t k = 0; k < nbBatch; ++k) {
+    const size_t n = elemFrame * frames;
+    fpga_tools::printPerf(std::cout, ("  lancement " + std::to_string(k)).c_str(), perf[k],
+                          n, 2 * n * sizeof(T), kFmaxMHz);
+  }
+  sycl::free(perf, q);
+#endif
+
+  sycl::free(a, q);
+  sycl::free(b, q);
+  return ok;
+}
 
 int main() {
   try {
@@ -138,65 +153,33 @@ int main() {
 #else
     auto sel = sycl::ext::intel::fpga_emulator_selector_v;
 #endif
-    sycl::queue q(sel, fpga_tools::exception_handler);
+    sycl::queue q(sel, fpga_tools::exception_handler,
+                  sycl::property::queue::enable_profiling{});
 
     std::cout << "Device : "
               << q.get_device().get_info<sycl::info::device::name>()
               << '\n';
 
-    const uint32_t rows     = 256 ; // 256 ok
-    const uint32_t cols     = 256 ; // 256 ok
-    const uint32_t   elements = rows * cols;
-
-    // Allocation des tableaux de Complex
-     Complex* a = sycl::malloc_shared<Complex>(
-      elements, q,
-      {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl1)}) ;
-
-    Complex* b = sycl::malloc_shared<Complex>(
-      elements, q,
-      {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl2)}) ;
-
-    // Génération et écriture dans le pipe
-    for (uint32_t r = 0; r < rows; ++r) {
-      for (uint32_t c = 0; c < cols; ++c) {
-        // On simule un complexe (re, im = .5)
-        Complex a_vec(float(r * cols + c),
-                      float(r * cols + c) + 0.5f);
-         std::cout << '(' << a_vec.real() << ',' << a_vec.imag() << ") ";
-        a[r * cols + c] = a_vec ;
-         //InputPipe::write(q, a_vec);
-      }
-      std::cout << '\n';
-    }
-
-    std::cout << "\nAprès transposition :\n";
-
-    // Lancement du kernel
-    q.single_task<TransposeKernel>(Transpose{a, b, rows, cols});
-    q.wait();
-
-    // Affichage et vérification
+    const uint32_t rows = 256 ; // 256 ok
+    const uint32_t cols = 256 ; // 256 ok
+
     bool ok = true;
-    for (uint32_t r = 0; r < cols; ++r) {
-      for (uint32_t c = 0; c < rows; ++c) {
-        Complex v = b[r * rows + c];
-         std::cout << '(' << v.real() << ',' << v.imag() << ") " ;//<< &b[r * rows + c]<<' ';
-        // On vérifie que la partie réelle est c*cols + r
-        // et que l'imaginaire est +0.5
-        if (v.r() != float(c * cols + r) ||          // réel
-    v.i() != float(c * cols + r) + 0.5f)     // imaginaire
-  ok = false;
-      }
-      std::cout << '\n';
-    }
+    ok &= testTranspose<int>(q, rows, cols, "int");
+    ok &= testTranspose<sycl::vec<float, 2>>(q, rows, cols, "sycl::vec<float,2>");
+    ok &= testTranspose<ac_complex<float>>(q, rows, cols, "ac_complex<float>");
+    ok &= testTranspose<ac_complex<int16_t>>(q, rows, cols, "ac_complex<int16_t>");
 
-    std::cout << (ok ? "PASSED\n" : "FAILED\n");
+    // Dimensions non multiples de la tuile (tuiles de bord partielles)
+    ok &= testTranspose<int>(q, 45, 37, "int 45x37");
+    ok &= testTranspose<ac_complex<float>>(q, 3000, 1200, "ac_complex<float> 3000x1200");
 
-    sycl::free(b, q);
+    // Batch : 4 lancements de 16 trames 256 × 256
+    ok &= testBatch<ac_complex<float>>(q, 256, 256, 16, 4, "batch ac_complex<float> 4 × 16");
+
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
     return ok ? EXIT_SUCCESS : EXIT_FAILURE;
   } catch (const sycl::exception& e) {
     std::cerr << "SYCL exception : " << e.what() << '\n';
     return EXIT_FAILURE;
   }
-}
\ No newline at end of file
+}
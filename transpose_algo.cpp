@@ -1,56 +1,73 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
-#include <string>
-#include <queue>
-
-int main () {
-
-    size_t ligne = 2048 ;
-    size_t colonne = 2048 ; // ça sera 2048, ça changera pas
-    u_int32_t element = ligne * colonne ;
-    
-    // Je veux faire les itérations 8 par 8 
-
-    size_t nbCols = 32 ;
-    size_t nbPass = ligne / nbCols;
-    
-    std::queue<int> myFifo ;
-    // remplie la fifo qui simule le pipe
-    for (u_int32_t i = 0 ; i < element ; i++){
-        myFifo.push(i);
-    }
-    int* t1 = new int [element] ; // tableau de sortie
-    int* buffer = new int [2048*32] ;
-    
-     for (size_t a = 0 ; a < nbPass ; a++ ){
-         std::cout << "Buffer de transposition: "<< a + 1 << "\n" ;
-         for (size_t i = 0 ; i < nbCols; i++){
-            for (size_t j = 0 ; j < colonne ; j++){
-                buffer[j*ligne+i] = myFifo.front() ;         // Transposé (2)   
-                std::cout << buffer[j*ligne+i] << ' ';  
-                myFifo.pop() ;
-            }
-            std::cout << "\n" ; 
-        }
-
-        std::cout << "\n\n" ;
-  
-        for (size_t j = 0 ; j < colonne ; j++){
-            for (size_t i = 0 ; i < nbCols ; i++){
-                t1[j*ligne+i + (nbCols *a)] = buffer[j*ligne+i] ;
-            }
-        } 
+#include <vector>
+
+#include "transpose_cpu.hpp"
+
+// Benchmark des transpositions hôte sur des matrices carrées 64 .. tailleMax
+//   – tuile   : tuiles fixes tTuile × tTuile, boucle scalaire (ancien algorithme)
+//   – bloc    : cpu::transpose, blocs kBloc + micro-tuiles SIMD
+//   – récursif: cpu::transposeRecursive, cache-oblivious
+// Usage : ./transpose_algo [tailleMax] [nbThreads]   (défaut 16384, 1)
+// 16384 × 16384 éléments 32 bits = 1 Gio par matrice.
+
+constexpr uint32_t tTuile = 32;
+
+void transposeTuile(const uint32_t* t0, uint32_t* t1, uint32_t ligne, uint32_t colonne) {
+    for (uint32_t a = 0; a < ligne; a += tTuile)
+        for (uint32_t b = 0; b < colonne; b += tTuile)
+            for (uint32_t i = a; i < std::min(a + tTuile, ligne); ++i)
+                for (uint32_t j = b; j < std::min(b + tTuile, colonne); ++j)
+                    t1[size_t(j) * ligne + i] = t0[size_t(i) * colonne + j];
+}
+
+// Meilleur temps (s) sur quelques répétitions
+template <typename F>
+double mesure(F&& f, int nbRep) {
+    double best = 1e30;
+    for (int k = 0; k < nbRep; ++k) {
+        auto d0 = std::chrono::steady_clock::now();
+        f();
+        auto d1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(d1 - d0).count());
     }
+    return best;
+}
+
+int main (int argc, char** argv) {
+    const uint32_t tailleMax = argc > 1 ? uint32_t(std::atoi(argv[1])) : 16384;
+    const unsigned nbThreads = argc > 2 ? unsigned(std::atoi(argv[2])) : 1;
+
+    std::cout << "taille   tuile(Go/s)  bloc(Go/s)  récursif(Go/s)\n";
+    bool ok = true;
+    for (uint32_t n = 64; n <= tailleMax; n *= 2) {
+        const size_t element = size_t(n) * n;
+        std::vector<uint32_t> t0(element), t1(element), t2(element), t3(element);
+        for (size_t i = 0; i < element; ++i)
+            t0[i] = uint32_t(i);
 
-     // Affichage de la matrice transposé 
-     for (size_t j = 0 ; j < colonne ; j++){
-        for (size_t i = 0 ; i < ligne ; i++){
-            std::cout << t1[j*ligne+i] << ' ' ; 
-        }
-    std::cout << "\n" ;
-} 
+        // Plus de répétitions pour les petites tailles
+        const int nbRep = n <= 1024 ? 20 : 3;
+        const double sTuile = mesure([&] { transposeTuile(t0.data(), t1.data(), n, n); }, nbRep);
+        const double sBloc = mesure([&] {
+            fpga_tools::cpu::transpose(t0.data(), t2.data(), n, n, 1, 0, nbThreads); }, nbRep);
+        const double sRec = mesure([&] {
+            fpga_tools::cpu::transposeRecursive(t0.data(), t3.data(), n, n, 1, 0, nbThreads); }, nbRep);
 
+        ok &= std::memcmp(t1.data(), t2.data(), element * sizeof(uint32_t)) == 0;
+        ok &= std::memcmp(t1.data(), t3.data(), element * sizeof(uint32_t)) == 0;
+
+        const double octets = 2.0 * element * sizeof(uint32_t);
+        std::cout << std::setw(6) << n << std::fixed << std::setprecision(2)
+                  << std::setw(13) << octets / sTuile / 1e9
+                  << std::setw(12) << octets / sBloc / 1e9
+                  << std::setw(16) << octets / sRec / 1e9 << '\n';
+    }
 
-    delete[] t1 ;
-    delete[] buffer ;
-    return 0 ;
-}
\ No newline at end of file
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+#ifndef __TRANSPOSE_CPU_HPP__
+#define __TRANSPOSE_CPU_HPP__
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// -----------------------------------------------------------------------------
+// Backend CPU de la transposition (référence et repli quand le FPGA est pris)
+//
+// Même convention que les kernels de transpose.hpp :
+//   in  : frames matrices rows × cols (row-major), espacées de stride éléments
+//   out : frames matrices cols × rows, même espacement (0 = rows × cols)
+//
+// La matrice est parcourue par blocs de kBloc × kBloc (tiennent en L1) ; dans
+// chaque bloc, les micro-tuiles sont transposées en registres :
+//   – éléments 32 bits (int, ac_complex<int16_t>) : 8 × 8 en AVX2
+//   – éléments 64 bits (complexes float)          : 4 × 4 en AVX2, 8 × 8 en AVX-512
+// Sans AVX2 (compiler avec -mavx2 / -xHost pour l'activer) on retombe sur une
+// boucle scalaire par blocs. Les bandes de blocs sont réparties sur les
+// threads par un compteur atomique.
+// transposeRecursive() est la variante cache-oblivious, sans taille de bloc.
+// -----------------------------------------------------------------------------
+
+namespace fpga_tools {
+namespace cpu {
+
+constexpr uint32_t kBloc = 64;
+
+// ---------- Micro-tuiles en registres ----------------------------------------
+// Micro<N>::K : côté de la micro-tuile pour des éléments de N octets
+// Micro<N>::tr(src, lds, dst, ldd) : dst[j][i] = src[i][j], i, j < K
+template <size_t N> struct Micro {
+  static constexpr uint32_t K = 1;
+};
+
+#if defined(__AVX2__)
+template <> struct Micro<4> {
+  static constexpr uint32_t K = 8;
+  static void tr(const void* src, size_t lds, void* dst, size_t ldd) {
+    const float* s = static_cast<const float*>(src);
+    float* d = static_cast<float*>(dst);
+    __m256 r0 = _mm256_loadu_ps(s + 0 * lds), r1 = _mm256_loadu_ps(s + 1 * lds);
+    __m256 r2 = _mm256_loadu_ps(s + 2 * lds), r3 = _mm256_loadu_ps(s + 3 * lds);
+    __m256 r4 = _mm256_loadu_ps(s + 4 * lds), r5 = _mm256_loadu_ps(s + 5 * lds);
+    __m256 r6 = _mm256_loadu_ps(s + 6 * lds), r7 = _mm256_loadu_ps(s + 7 * lds);
+
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3), t3 = _mm256_unpackhi_ps(r2, r3);
+    __m256 t4 = _mm256_unpacklo_ps(r4, r5), t5 = _mm256_unpackhi_ps(r4, r5);
+    __m256 t6 = _mm256_unpacklo_ps(r6, r7), t7 = _mm256_unpackhi_ps(r6, r7);
+
+    __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(d + 0 * ldd, _mm256_permute2f128_ps(u0, u4, 0x20));
+    _mm256_storeu_ps(d + 1 * ldd, _mm256_permute2f128_ps(u1, u5, 0x20));
+    _mm256_storeu_ps(d + 2 * ldd, _mm256_permute2f128_ps(u2, u6, 0x20));
+    _mm256_storeu_ps(d + 3 * ldd, _mm256_permute2f128_ps(u3, u7, 0x20));
+    _mm256_storeu_ps(d + 4 * ldd, _mm256_permute2f128_ps(u0, u4, 0x31));
+    _mm256_storeu_ps(d + 5 * ldd, _mm256_permute2f128_ps(u1, u5, 0x31));
+    _mm256_storeu_ps(d + 6 * ldd, _mm256_permute2f128_ps(u2, u6, 0x31));
+    _mm256_storeu_ps(d + 7 * ldd, _mm256_permute2f128_ps(u3, u7, 0x31));
+  }
+};
+#endif
+
+#if defined(__AVX512F__)
+template <> struct Micro<8> {
+  static constexpr uint32_t K = 8;
+  static void tr(const void* src, size_t lds, void* dst, size_t ldd) {
+    const double* s = static_cast<const double*>(src);
+    double* d = static_cast<double*>(dst);
+    __m512d r0 = _mm512_loadu_pd(s + 0 * lds), r1 = _mm512_loadu_pd(s + 1 * lds);
+    __m512d r2 = _mm512_loadu_pd(s + 2 * lds), r3 = _mm512_loadu_pd(s + 3 * lds);
+    __m512d r4 = _mm512_loadu_pd(s + 4 * lds), r5 = _mm512_loadu_pd(s + 5 * lds);
+    __m512d r6 = _mm512_loadu_pd(s + 6 * lds), r7 = _mm512_loadu_pd(s + 7 * lds);
+
+    __m512d t0 = _mm512_unpacklo_pd(r0, r1), t1 = _mm512_unpackhi_pd(r0, r1);
+    __m512d t2 = _mm512_unpacklo_pd(r2, r3), t3 = _mm512_unpackhi_pd(r2, r3);
+    __m512d t4 = _mm512_unpacklo_pd(r4, r5), t5 = _mm512_unpackhi_pd(r4, r5);
+    __m512d t6 = _mm512_unpacklo_pd(r6, r7), t7 = _mm512_unpackhi_pd(r6, r7);
+
+    // 0x88 : voies 128 bits (0, 2) de chaque source, 0xdd : voies (1, 3)
+    __m512d u0 = _mm512_shuffle_f64x2(t0, t2, 0x88), u2 = _mm512_shuffle_f64x2(t0, t2, 0xdd);
+    __m512d u1 = _mm512_shuffle_f64x2(t1, t3, 0x88), u3 = _mm512_shuffle_f64x2(t1, t3, 0xdd);
+    __m512d u4 = _mm512_shuffle_f64x2(t4, t6, 0x88), u6 = _mm512_shuffle_f64x2(t4, t6, 0xdd);
+    __m512d u5 = _mm512_shuffle_f64x2(t5, t7, 0x88), u7 = _mm512_shuffle_f64x2(t5, t7, 0xdd);
+
+    _mm512_storeu_pd(d + 0 * ldd, _mm512_shuffle_f64x2(u0, u4, 0x88));
+    _mm512_storeu_pd(d + 1 * ldd, _mm512_shuffle_f64x2(u1, u5, 0x88));
+    _mm512_storeu_pd(d + 2 * ldd, _mm512_shuffle_f64x2(u2, u6, 0x88));
+    _mm512_storeu_pd(d + 3 * ldd, _mm512_shuffle_f64x2(u3, u7, 0x88));
+    _mm512_storeu_pd(d + 4 * ldd, _mm512_shuffle_f64x2(u0, u4, 0xdd));
+    _mm512_storeu_pd(d + 5 * ldd, _mm512_shuffle_f64x2(u1, u5, 0xdd));
+    _mm512_storeu_pd(d + 6 * ldd, _mm512_shuffle_f64x2(u2, u6, 0xdd));
+    _mm512_storeu_pd(d + 7 * ldd, _mm512_shuffle_f64x2(u3, u7, 0xdd));
+  }
+};
+#elif defined(__AVX2__)
+template <> struct Micro<8> {
+  static constexpr uint32_t K = 4;
+  static void tr(const void* src, size_t lds, void* dst, size_t ldd) {
+    const double* s = static_cast<const double*>(src);
+    double* d = static_cast<double*>(dst);
+    __m256d r0 = _mm256_loadu_pd(s + 0 * lds), r1 = _mm256_loadu_pd(s + 1 * lds);
+    __m256d r2 = _mm256_loadu_pd(s + 2 * lds), r3 = _mm256_loadu_pd(s + 3 * lds);
+
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+
+    _mm256_storeu_pd(d + 0 * ldd, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(d + 1 * ldd, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(d + 2 * ldd, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(d + 3 * ldd, _mm256_permute2f128_pd(t1, t3, 0x31));
+  }
+};
+#endif
+
+// ---------- Bloc h × w --------------------------------------------------------
+// out[j * ldo + i] = in[i * ldi + j], i < h, j < w
+// Les éléments ne sont que déplacés : seule leur taille compte.
+template <typename T>
+void transposeBloc(const T* in, size_t ldi, T* out, size_t ldo, uint32_t h, uint32_t w) {
+  using M = Micro<sizeof(T)>;
+  constexpr uint32_t K = M::K;
+  uint32_t i = 0;
+  if constexpr (K > 1) {
+    for (; i + K <= h; i += K) {
+      uint32_t j = 0;
+      for (; j + K <= w; j += K)
+        M::tr(in + i * ldi + j, ldi, out + j * ldo + i, ldo);
+      for (; j < w; j++)
+        for (uint32_t ii = i; ii < i + K; ii++)
+          out[j * ldo + ii] = in[ii * ldi + j];
+    }
+  }
+  for (; i < h; i++)
+    for (uint32_t j = 0; j < w; j++)
+      out[j * ldo + i] = in[i * ldi + j];
+}
+
+// ---------- Transposition complète, multithread ------------------------------
+// nbThreads = 0 : autant que de coeurs
+template <typename T>
+void transpose(const T* in, T* out, uint32_t rows, uint32_t cols,
+               uint32_t frames = 1, uint64_t stride = 0, unsigned nbThreads = 0) {
+  const uint64_t pas = stride ? stride : uint64_t(rows) * cols;
+  const uint32_t nbBandes = (rows + kBloc - 1) / kBloc;
+  const uint64_t nbTaches = uint64_t(nbBandes) * frames;
+
+  if (nbThreads == 0)
+    nbThreads = std::max(1u, std::thread::hardware_concurrency());
+  nbThreads = unsigned(std::min<uint64_t>(nbThreads, nbTaches));
+
+  // Une tâche = une bande de kBloc lignes d'une trame, parcourue par blocs
+  std::atomic<uint64_t> suivante{0};
+  auto travail = [&]() {
+    for (uint64_t t; (t = suivante.fetch_add(1)) < nbTaches;) {
+      const uint64_t f = t / nbBandes;
+      const uint32_t r0 = uint32_t(t % nbBandes) * kBloc;
+      const uint32_t h = std::min(kBloc, rows - r0);
+      const T* src = in + f * pas;
+      T* dst = out + f * pas;
+      for (uint32_t c0 = 0; c0 < cols; c0 += kBloc)
+        transposeBloc(src + size_t(r0) * cols + c0, cols,
+                      dst + size_t(c0) * rows + r0, rows,
+                      h, std::min(kBloc, cols - c0));
+    }
+  };
+
+  if (nbThreads <= 1) {
+    travail();
+    return;
+  }
+  std::vector<std::thread> pool;
+  for (unsigned k = 0; k < nbThreads; k++)
+    pool.emplace_back(travail);
+  for (auto& th : pool)
+    th.join();
+}
+
+// ---------- Variante cache-oblivious -----------------------------------------
+// Coupe récursivement la plus grande dimension en deux jusqu'à une feuille
+// de kFeuille × kFeuille au plus : à chaque niveau de cache correspond une
+// profondeur de récursion où le sous-problème y tient, sans taille de bloc à
+// régler. kFeuille sert seulement à amortir les appels et reste un multiple
+// des micro-tuiles.
+constexpr uint32_t kFeuille = 16;
+
+template <typename T>
+void transposeRec(const T* in, size_t ldi, T* out, size_t ldo, uint32_t h, uint32_t w) {
+  if (h <= kFeuille && w <= kFeuille) {
+    transposeBloc(in, ldi, out, ldo, h, w);
+  } else if (h >= w) {
+    const uint32_t h2 = h / 2;
+    transposeRec(in, ldi, out, ldo, h2, w);
+    transposeRec(in + h2 * ldi, ldi, out + h2, ldo, h - h2, w);
+  } else {
+    const uint32_t w2 = w / 2;
+    transposeRec(in, ldi, out, ldo, h, w2);
+    transposeRec(in + w2, ldi, out + w2 * ldo, ldo, h, w - w2);
+  }
+}
+
+// Même interface que transpose() ; chaque thread traite une bande de lignes
+// d'une trame par récursion
+template <typename T>
+void transposeRecursive(const T* in, T* out, uint32_t rows, uint32_t cols,
+                        uint32_t frames = 1, uint64_t stride = 0, unsigned nbThreads = 0) {
+  const uint64_t pas = stride ? stride : uint64_t(rows) * cols;
+
+  if (nbThreads == 0)
+    nbThreads = std::max(1u, std::thread::hardware_concurrency());
+  const uint32_t nbBandes = std::max(1u, std::min<uint32_t>(nbThreads, rows / kFeuille));
+  const uint64_t nbTaches = uint64_t(nbBandes) * frames;
+  nbThreads = unsigned(std::min<uint64_t>(nbThreads, nbTaches));
+
+  std::atomic<uint64_t> suivante{0};
+  auto travail = [&]() {
+    for (uint64_t t; (t = suivante.fetch_add(1)) < nbTaches;) {
+      const uint64_t f = t / nbBandes;
+      const uint32_t b = uint32_t(t % nbBandes);
+      const uint32_t r0 = uint32_t(uint64_t(rows) * b / nbBandes);
+      const uint32_t r1 = uint32_t(uint64_t(rows) * (b + 1) / nbBandes);
+      transposeRec(in + f * pas + size_t(r0) * cols, cols,
+                   out + f * pas + r0, rows, r1 - r0, cols);
+    }
+  };
+
+  if (nbThreads <= 1) {
+    travail();
+    return;
+  }
+  std::vector<std::thread> pool;
+  for (unsigned k = 0; k < nbThreads; k++)
+    pool.emplace_back(travail);
+  for (auto& th : pool)
+    th.join();
+}
+
+} // namespace cpu
+} // namespace fpga_tools
+
+#endif //__TRANSPOSE_CPU_HPP__
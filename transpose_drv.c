@@ -0,0 +1,311 @@
+/******************************************************************************
+ *  Pilote Nios II de l'IP transpose — voir transpose_drv.h
+ *
+ *  Une seule requête tourne à la fois sur l'IP ; les suivantes attendent dans
+ *  une file circulaire de pointeurs. L'ISR acquitte l'IRQ done, termine la
+ *  requête courante et démarre la suivante : l'IP enchaîne les trames sans
+ *  intervention du programme principal.
+ *
+ *  La file est partagée entre l'ISR et le programme principal : côté
+ *  programme, toute modification se fait IRQ masquées (alt_irq_disable_all).
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <io.h>            /* IOWR_32DIRECT / IORD_32DIRECT          */
+#include <sys/alt_irq.h>   /* alt_ic_isr_register(), alt_irq_*_all() */
+#include <sys/alt_cache.h> /* alt_dcache_flush*()                    */
+
+#include "transpose_drv.h"
+
+#define QMASK (TRANSPOSE_QUEUE_DEPTH - 1)
+
+#if (TRANSPOSE_QUEUE_DEPTH & QMASK) != 0
+#error "TRANSPOSE_QUEUE_DEPTH doit être une puissance de 2"
+#endif
+
+/* ---------- Helper : write 64-bit CSR argument -------------------------- */
+#define IOWR64(base, off, val64)                         \
+    do {                                                 \
+        IOWR_32DIRECT((base), (off),      (uint32_t)(val64));      \
+        IOWR_32DIRECT((base), (off) + 4U, (uint32_t)((uint64_t)(val64) >> 32)); \
+    } while (0)
+
+/* ---------- Démarrage de la requête en tête (IRQ masquées ou ISR) -------- */
+static void start_next(transpose_dev_t *dev)
+{
+    if (dev->running != NULL || dev->head == dev->tail)
+        return;
+
+    transpose_req_t *r = dev->queue[dev->head & QMASK];
+    dev->head++;
+
+    IOWR64(dev->csr, TRANSPOSE_ARG_IN_OFF,  (uint64_t)(uintptr_t)r->in);
+    IOWR64(dev->csr, TRANSPOSE_ARG_OUT_OFF, (uint64_t)(uintptr_t)r->out);
+    IOWR_32DIRECT(dev->csr, TRANSPOSE_ARG_ROWS_OFF, r->rows);
+    IOWR_32DIRECT(dev->csr, TRANSPOSE_ARG_COLS_OFF, r->cols);
+
+    dev->running = r;
+    r->state = TRANSPOSE_REQ_RUNNING;
+
+    /* Start : flanc montant */
+    IOWR_32DIRECT(dev->csr, TRANSPOSE_START_OFF, 1);
+    IOWR_32DIRECT(dev->csr, TRANSPOSE_START_OFF, 0);
+}
+
+/* ---------- ISR : fin de kernel ----------------------------------------- */
+static void transpose_isr(void *context)
+{
+    transpose_dev_t *dev = (transpose_dev_t *)context;
+
+    /* Acquitte l'IRQ, puis vide le compteur de fins et le bit DONE */
+    IOWR_32DIRECT(dev->csr, TRANSPOSE_IRQ_STATUS_OFF, TRANSPOSE_IRQ_MASK);
+    (void)IORD_32DIRECT(dev->csr, TRANSPOSE_FINISH_CNT_OFF);
+    (void)IORD_32DIRECT(dev->csr, TRANSPOSE_STATUS_OFF);
+    dev->nb_irq++;
+
+    transpose_req_t *r = dev->running;
+    if (r != NULL) {
+        dev->running = NULL;
+        dev->nb_done++;
+        r->state = TRANSPOSE_REQ_DONE;
+        if (r->cb != NULL)
+            r->cb(r, r->user);
+    }
+
+    start_next(dev);
+}
+
+/* ---------- API ---------------------------------------------------------- */
+int transpose_init(transpose_dev_t *dev, uint32_t csr_base,
+                   uint32_t irq_ic_id, uint32_t irq)
+{
+    if (dev == NULL)
+        return TRANSPOSE_EINVAL;
+
+    dev->csr     = csr_base;
+    dev->head    = 0;
+    dev->tail    = 0;
+    dev->running = NULL;
+    dev->nb_done = 0;
+    dev->nb_irq  = 0;
+
+    /* L'IP doit être libre avant de prendre la main */
+    while (IORD_32DIRECT(csr_base, TRANSPOSE_STATUS_OFF) & TRANSPOSE_BUSY_MASK)
+        ;
+    IOWR_32DIRECT(csr_base, TRANSPOSE_IRQ_STATUS_OFF, TRANSPOSE_IRQ_MASK);
+    (void)IORD_32DIRECT(csr_base, TRANSPOSE_FINISH_CNT_OFF);
+
+    if (alt_ic_isr_register(irq_ic_id, irq, transpose_isr, dev, NULL) != 0)
+        return TRANSPOSE_EIRQ;
+
+    IOWR_32DIRECT(csr_base, TRANSPOSE_IRQ_ENABLE_OFF, TRANSPOSE_IRQ_MASK);
+    return TRANSPOSE_OK;
+}
+
+int transpose_submit(transpose_dev_t *dev, transpose_req_t *req)
+{
+    if (dev == NULL || req == NULL || req->rows == 0 || req->cols == 0 ||
+        req->state == TRANSPOSE_REQ_QUEUED || req->state == TRANSPOSE_REQ_RUNNING)
+        return TRANSPOSE_EINVAL;
+
+    alt_irq_context ctx = alt_irq_disable_all();
+    if (dev->tail - dev->head == TRANSPOSE_QUEUE_DEPTH) {
+        alt_irq_enable_all(ctx);
+        return TRANSPOSE_EBUSY;
+    }
+    req->state = TRANSPOSE_REQ_QUEUED;
+    dev->queue[dev->tail & QMASK] = req;
+    dev->tail++;
+    start_next(dev);
+    alt_irq_enable_all(ctx);
+
+    return TRANSPOSE_OK;
+}
+
+int transpose_poll(transpose_dev_t *dev, transpose_req_t *req)
+{
+    (void)dev;
+    switch (req->state) {
+    case TRANSPOSE_REQ_QUEUED:
+    case TRANSPOSE_REQ_RUNNING:
+        return 0;
+    case TRANSPOSE_REQ_DONE:
+        /* Invalide avant lecture par le CPU, sans réécriture : une ligne
+         * sale de out écraserait le résultat de l'IP */
+        if (req->out_bytes != 0)
+            alt_dcache_flush_no_writeback(req->out, req->out_bytes);
+        req->state = TRANSPOSE_REQ_IDLE;
+        return 1;
+    default:
+        return 1;
+    }
+}
+
+void transpose_wait(transpose_dev_t *dev, transpose_req_t *req)
+{
+    /* L'état n'évolue que dans l'ISR : on boucle sur la RAM, pas sur la CSR */
+    while (!transpose_poll(dev, req))
+        ;
+}
+
+uint32_t transpose_pending(const transpose_dev_t *dev)
+{
+    return (dev->tail - dev->head) + (dev->running != NULL ? 1U : 0U);
+}
+
+void transpose_flush_in(const void *in, uint32_t bytes)
+{
+    alt_dcache_flush((void *)in, bytes);
+}
+
+void transpose_shutdown(transpose_dev_t *dev)
+{
+    IOWR_32DIRECT(dev->csr, TRANSPOSE_IRQ_ENABLE_OFF, 0);
+
+    alt_irq_context ctx = alt_irq_disable_all();
+    while (dev->head != dev->tail) {
+        dev->queue[dev->head & QMASK]->state = TRANSPOSE_REQ_IDLE;
+        dev->head++;
+    }
+    alt_irq_enable_all(ctx);
+
+    /* La requête en cours va jusqu'au bout, sans IRQ */
+    while (IORD_32DIRECT(dev->csr, TRANSPOSE_STATUS_OFF) & TRANSPOSE_BUSY_MASK)
+        ;
+    if (dev->running != NULL) {
+        dev->running->state = TRANSPOSE_REQ_DONE;
+        dev->running = NULL;
+    }
+}
+
+/* ========================================================================
+ *  Mode anneau de descripteurs
+ * ======================================================================== */
+
+/* ---------- Lance un lot avec les descripteurs en attente --------------- */
+static void ring_kick(transpose_ring_t *ring)
+{
+    const uint32_t count = ring->head - ring->issued;
+    if (ring->busy || count == 0)
+        return;
+
+    IOWR_32DIRECT(ring->csr, TRANSPOSE_RING_ARG_FIRST_OFF, ring->issued % ring->size);
+    IOWR_32DIRECT(ring->csr, TRANSPOSE_RING_ARG_COUNT_OFF, count);
+    ring->issued = ring->head;
+    ring->busy = 1;
+    ring->nb_lots++;
+
+    IOWR_32DIRECT(ring->csr, TRANSPOSE_START_OFF, 1);
+    IOWR_32DIRECT(ring->csr, TRANSPOSE_START_OFF, 0);
+}
+
+/* ---------- ISR : fin de lot --------------------------------------------- */
+static void transpose_ring_isr(void *context)
+{
+    transpose_ring_t *ring = (transpose_ring_t *)context;
+
+    IOWR_32DIRECT(ring->csr, TRANSPOSE_IRQ_STATUS_OFF, TRANSPOSE_IRQ_MASK);
+    (void)IORD_32DIRECT(ring->csr, TRANSPOSE_FINISH_CNT_OFF);
+    (void)IORD_32DIRECT(ring->csr, TRANSPOSE_STATUS_OFF);
+
+    ring->busy = 0;
+    ring_kick(ring);
+}
+
+/* ---------- API ---------------------------------------------------------- */
+int transpose_ring_init(transpose_ring_t *ring, uint32_t csr_base,
+                        uint32_t irq_ic_id, uint32_t irq,
+                        transpose_desc_t *desc, const void *desc_ip, uint32_t size)
+{
+    /* size puissance de 2 : head % size reste continu quand les compteurs
+     * libres repassent par 0, comme pour la file (QMASK)                   */
+    if (ring == NULL || desc == NULL || desc_ip == NULL || size == 0 ||
+        (size & (size - 1)) != 0 ||
+        ((uintptr_t)desc & 31) != 0 || ((uintptr_t)desc_ip & 31) != 0)
+        return TRANSPOSE_EINVAL;
+
+    ring->csr     = csr_base;
+    ring->desc    = desc;
+    ring->cached  = (const void *)desc == desc_ip;
+    ring->size    = size;
+    ring->head    = 0;
+    ring->issued  = 0;
+    ring->tail    = 0;
+    ring->seq     = 0;
+    ring->busy    = 0;
+    ring->nb_lots = 0;
+
+    for (uint32_t i = 0; i < size; ++i)
+        ring->desc[i] = (transpose_desc_t){ 0 };
+    if (ring->cached)
+        alt_dcache_flush((void *)desc, size * sizeof(transpose_desc_t));
+
+    while (IORD_32DIRECT(csr_base, TRANSPOSE_STATUS_OFF) & TRANSPOSE_BUSY_MASK)
+        ;
+    IOWR_32DIRECT(csr_base, TRANSPOSE_IRQ_STATUS_OFF, TRANSPOSE_IRQ_MASK);
+    (void)IORD_32DIRECT(csr_base, TRANSPOSE_FINISH_CNT_OFF);
+
+    /* Arguments fixes : écrits une fois pour toutes */
+    IOWR64(csr_base, TRANSPOSE_RING_ARG_IN_OFF,   0);
+    IOWR64(csr_base, TRANSPOSE_RING_ARG_OUT_OFF,  0);
+    IOWR64(csr_base, TRANSPOSE_RING_ARG_RING_OFF, (uint64_t)(uintptr_t)desc_ip);
+    IOWR_32DIRECT(csr_base, TRANSPOSE_RING_ARG_RINGSIZE_OFF, size);
+
+    if (alt_ic_isr_register(irq_ic_id, irq, transpose_ring_isr, ring, NULL) != 0)
+        return TRANSPOSE_EIRQ;
+
+    IOWR_32DIRECT(csr_base, TRANSPOSE_IRQ_ENABLE_OFF, TRANSPOSE_IRQ_MASK);
+    return TRANSPOSE_OK;
+}
+
+int32_t transpose_ring_push(transpose_ring_t *ring, const void *in, void *out,
+                            uint32_t rows, uint32_t cols)
+{
+    if (rows == 0 || cols == 0)
+        return TRANSPOSE_EINVAL;
+    if (ring->head - ring->tail == ring->size)
+        return TRANSPOSE_EBUSY;
+
+    /* seq reste dans [1, INT32_MAX] : jamais confondu avec un code d'erreur */
+    ring->seq = ring->seq >= INT32_MAX ? 1 : ring->seq + 1;
+
+    volatile transpose_desc_t *d = &ring->desc[ring->head % ring->size];
+    d->in     = (uint64_t)(uintptr_t)in;
+    d->out    = (uint64_t)(uintptr_t)out;
+    d->rows   = rows;
+    d->cols   = cols;
+    d->seq    = ring->seq;
+    d->status = 0;
+    if (ring->cached)
+        alt_dcache_flush((void *)d, sizeof(transpose_desc_t));
+
+    alt_irq_context ctx = alt_irq_disable_all();
+    ring->head++;
+    ring_kick(ring);
+    alt_irq_enable_all(ctx);
+
+    return (int32_t)ring->seq;
+}
+
+const volatile transpose_desc_t *transpose_ring_reap(transpose_ring_t *ring)
+{
+    if (ring->tail == ring->issued)
+        return NULL;
+
+    volatile transpose_desc_t *d = &ring->desc[ring->tail % ring->size];
+    /* Invalidation seule : une ligne sale ne doit pas écraser le status que
+     * l'IP vient d'écrire */
+    if (ring->cached)
+        alt_dcache_flush_no_writeback((void *)d, sizeof(transpose_desc_t));
+    if (d->status != d->seq)
+        return NULL;
+
+    ring->tail++;
+    return d;
+}
+
+uint32_t transpose_ring_pending(const transpose_ring_t *ring)
+{
+    return ring->head - ring->tail;
+}
@@ -0,0 +1,215 @@
+/******************************************************************************
+ *  Pilote Nios II de l'IP transpose (kernel oneAPI à interface CSR)
+ *
+ *  – Fin de kernel signalée par l'IRQ "done" de l'IP, plus d'attente active
+ *  – Soumission asynchrone : transpose_submit() range la requête dans une
+ *    file de TRANSPOSE_QUEUE_DEPTH entrées et rend la main ; l'ISR démarre la
+ *    requête suivante dès que l'IP a fini la précédente
+ *  – Récupération : transpose_poll() (non bloquant) ou transpose_wait()
+ *  – Mode anneau (IP TransposeRing) : l'hôte écrit des descripteurs en RAM
+ *    on-chip, l'IP les enchaîne seule ; un accès CSR par lot, pas par trame
+ *
+ *  Usage type (double tampon) :
+ *      transpose_init(&dev, CSR_BASE, IRQ_IC_ID, IRQ);
+ *      transpose_submit(&dev, &req[k]);      préparer la trame k + 1 ...
+ *      transpose_wait(&dev, &req[k]);        ... post-traiter la trame k
+ ******************************************************************************/
+
+#ifndef __TRANSPOSE_DRV_H__
+#define __TRANSPOSE_DRV_H__
+
+#include <stdint.h>
+
+/* ---------- Offsets CSR -------------------------------------------------
+ * Pris dans transpose_csr.h quand il existe : en-tête généré par gen_csr.py
+ * depuis le rapport de transpose_ip.cpp (cible cmake csr_header) : kernels
+ * TransposeCsrIP -> TRANSPOSE et TransposeRingIP -> TRANSPOSE_RING. Sinon,
+ * valeurs de la carte actuelle ci-dessous.                                 */
+#if defined(__has_include)
+#if __has_include("transpose_csr.h")
+#include "transpose_csr.h"
+#endif
+#endif
+
+/* Chaque valeur a son propre garde : un en-tête généré partiel ne laisse pas
+ * d'offset indéfini (gen_csr.py --need vérifie que les arguments existent) */
+#ifndef TRANSPOSE_STATUS_OFF
+#define TRANSPOSE_STATUS_OFF        0x00  /* R : bit 1 = DONE, bit 2 = BUSY  */
+#endif
+#ifndef TRANSPOSE_START_OFF
+#define TRANSPOSE_START_OFF         0x08
+#endif
+#ifndef TRANSPOSE_IRQ_ENABLE_OFF
+#define TRANSPOSE_IRQ_ENABLE_OFF    0x10  /* bit 0 : IRQ done autorisée      */
+#endif
+#ifndef TRANSPOSE_IRQ_STATUS_OFF
+#define TRANSPOSE_IRQ_STATUS_OFF    0x18  /* bit 0 : done, écrire 1 efface   */
+#endif
+#ifndef TRANSPOSE_FINISH_CNT_OFF
+#define TRANSPOSE_FINISH_CNT_OFF    0x20  /* nb de fins depuis la lecture    */
+#endif
+#ifndef TRANSPOSE_ARG_IN_OFF
+#define TRANSPOSE_ARG_IN_OFF        0x80
+#endif
+#ifndef TRANSPOSE_ARG_OUT_OFF
+#define TRANSPOSE_ARG_OUT_OFF       0x88
+#endif
+#ifndef TRANSPOSE_ARG_ROWS_OFF
+#define TRANSPOSE_ARG_ROWS_OFF      0x90
+#endif
+#ifndef TRANSPOSE_ARG_COLS_OFF
+#define TRANSPOSE_ARG_COLS_OFF      0x94
+#endif
+
+/* ---------- Masques ------------------------------------------------------ */
+#define TRANSPOSE_DONE_MASK  0x2
+#define TRANSPOSE_BUSY_MASK  0x4
+#define TRANSPOSE_IRQ_MASK   0x1
+
+/* ---------- File de requêtes (puissance de 2) ---------------------------- */
+#ifndef TRANSPOSE_QUEUE_DEPTH
+#define TRANSPOSE_QUEUE_DEPTH 8
+#endif
+
+/* ---------- Codes retour ------------------------------------------------- */
+#define TRANSPOSE_OK      0
+#define TRANSPOSE_EBUSY  -1   /* file pleine                              */
+#define TRANSPOSE_EINVAL -2   /* argument invalide                        */
+#define TRANSPOSE_EIRQ   -3   /* enregistrement de l'ISR refusé           */
+
+typedef enum {
+    TRANSPOSE_REQ_IDLE = 0,
+    TRANSPOSE_REQ_QUEUED,     /* dans la file, pas encore démarrée        */
+    TRANSPOSE_REQ_RUNNING,    /* démarrée sur l'IP                        */
+    TRANSPOSE_REQ_DONE        /* terminée (ISR), out pas encore invalidé  */
+} transpose_state_t;
+
+typedef struct transpose_req transpose_req_t;
+typedef void (*transpose_cb_t)(transpose_req_t *req, void *user);
+
+struct transpose_req {
+    /* Rempli par l'appelant */
+    const void    *in;        /* rows × cols, vu par l'IP                 */
+    void          *out;       /* cols × rows                              */
+    uint32_t       rows;
+    uint32_t       cols;
+    uint32_t       out_bytes; /* zone de out à invalider (0 : aucune)     */
+    transpose_cb_t cb;        /* appelée depuis l'ISR, NULL possible      */
+    void          *user;
+
+    /* Géré par le pilote */
+    volatile transpose_state_t state;
+};
+
+typedef struct {
+    uint32_t          csr;
+    transpose_req_t  *queue[TRANSPOSE_QUEUE_DEPTH];
+    volatile uint32_t head;     /* prochaine requête à démarrer           */
+    volatile uint32_t tail;     /* prochaine place libre                  */
+    transpose_req_t  *volatile running;
+    volatile uint32_t nb_done;  /* statistiques                           */
+    volatile uint32_t nb_irq;
+} transpose_dev_t;
+
+/* Initialise le pilote, enregistre l'ISR et autorise l'IRQ done de l'IP */
+int  transpose_init(transpose_dev_t *dev, uint32_t csr_base,
+                    uint32_t irq_ic_id, uint32_t irq);
+
+/* Enfile req (état IDLE ou DONE) ; démarre l'IP si elle est libre.
+ * in doit avoir été flushé du cache par l'appelant (transpose_flush_in). */
+int  transpose_submit(transpose_dev_t *dev, transpose_req_t *req);
+
+/* Non bloquant : 1 si req n'est ni en file ni en cours, 0 sinon.
+ * Au passage DONE -> IDLE, invalide le cache sur out_bytes octets de out,
+ * sans réécriture : out doit occuper des lignes de cache entières.        */
+int  transpose_poll(transpose_dev_t *dev, transpose_req_t *req);
+
+/* Bloquant, sans attente active sur la CSR : attend l'IRQ de fin de req */
+void transpose_wait(transpose_dev_t *dev, transpose_req_t *req);
+
+/* Nombre de requêtes en file ou en cours */
+uint32_t transpose_pending(const transpose_dev_t *dev);
+
+/* Écrit en mémoire les lignes de cache de in avant soumission */
+void transpose_flush_in(const void *in, uint32_t bytes);
+
+/* Coupe l'IRQ de l'IP ; les requêtes en file sont abandonnées (IDLE) */
+void transpose_shutdown(transpose_dev_t *dev);
+
+/* ========================================================================
+ *  Mode anneau de descripteurs (kernel fpga_tools::TransposeRing)
+ *
+ *  Le kernel lit ring[first .. first + count[ (modulo size), transpose chaque
+ *  trame puis recopie seq dans status. L'ISR relance aussitôt un lot avec
+ *  les descripteurs ajoutés pendant le précédent : tant que l'hôte garde de
+ *  l'avance, l'IP ne s'arrête qu'un instant par lot, jamais par trame.
+ * ======================================================================== */
+
+/* ---------- Offsets des arguments de TransposeRing ----------------------
+ * Registres de contrôle identiques à ceux de l'IP simple (TRANSPOSE_*_OFF) */
+#ifndef TRANSPOSE_RING_ARG_IN_OFF
+#define TRANSPOSE_RING_ARG_IN_OFF       0x80
+#endif
+#ifndef TRANSPOSE_RING_ARG_OUT_OFF
+#define TRANSPOSE_RING_ARG_OUT_OFF      0x88
+#endif
+#ifndef TRANSPOSE_RING_ARG_RING_OFF
+#define TRANSPOSE_RING_ARG_RING_OFF     0x90
+#endif
+#ifndef TRANSPOSE_RING_ARG_RINGSIZE_OFF
+#define TRANSPOSE_RING_ARG_RINGSIZE_OFF 0x98
+#endif
+#ifndef TRANSPOSE_RING_ARG_FIRST_OFF
+#define TRANSPOSE_RING_ARG_FIRST_OFF    0x9C
+#endif
+#ifndef TRANSPOSE_RING_ARG_COUNT_OFF
+#define TRANSPOSE_RING_ARG_COUNT_OFF    0xA0
+#endif
+
+/* Même disposition que fpga_tools::TransposeDesc (32 octets, une ligne de
+ * cache) ; in / out : adresses Avalon vues par l'IP                        */
+typedef struct {
+    uint64_t in;
+    uint64_t out;
+    uint32_t rows;       /* 0 : descripteur ignoré                      */
+    uint32_t cols;
+    uint32_t seq;        /* écrit par l'hôte, dans [1, INT32_MAX]       */
+    uint32_t status;     /* = seq quand la trame est en mémoire         */
+} transpose_desc_t;
+
+typedef struct {
+    uint32_t                   csr;
+    volatile transpose_desc_t *desc;  /* size descripteurs, côté CPU    */
+    uint32_t                   size;
+    uint32_t                   cached;/* desc passe par le cache        */
+    uint32_t                   head;  /* compteurs libres, modulo size  */
+    volatile uint32_t          issued;/* premier non confié à l'IP      */
+    uint32_t                   tail;  /* plus ancien non récupéré       */
+    uint32_t                   seq;
+    volatile uint32_t          busy;  /* un lot tourne sur l'IP         */
+    volatile uint32_t          nb_lots;
+} transpose_ring_t;
+
+/* desc : size descripteurs (size puissance de 2, sinon TRANSPOSE_EINVAL)
+ * alignés sur 32 octets, vus par le CPU ; desc_ip :
+ * la même zone vue par l'IP. Idéalement de l'on-chip allouée NBUF_UNCACHED
+ * (desc = .cpu, desc_ip = .ip) : aucune maintenance de cache. Si desc ==
+ * desc_ip, le pilote flushe et invalide chaque descripteur qu'il touche.   */
+int  transpose_ring_init(transpose_ring_t *ring, uint32_t csr_base,
+                         uint32_t irq_ic_id, uint32_t irq,
+                         transpose_desc_t *desc, const void *desc_ip,
+                         uint32_t size);
+
+/* Ajoute une trame ; rend son seq (1..INT32_MAX) ou TRANSPOSE_EBUSY si
+ * l'anneau est plein. in doit avoir été flushé du cache par l'appelant.   */
+int32_t transpose_ring_push(transpose_ring_t *ring, const void *in, void *out,
+                            uint32_t rows, uint32_t cols);
+
+/* Non bloquant : rend le plus ancien descripteur terminé et le libère, ou
+ * NULL. L'invalidation du cache de out reste à la charge de l'appelant.   */
+const volatile transpose_desc_t *transpose_ring_reap(transpose_ring_t *ring);
+
+/* Nombre de descripteurs ajoutés et non encore récupérés */
+uint32_t transpose_ring_pending(const transpose_ring_t *ring);
+
+#endif /* __TRANSPOSE_DRV_H__ */
@@ -3,11 +3,18 @@
 #include "exception_handler.hpp"
 #include <sycl/ext/intel/ac_types/ac_complex.hpp>
 
-#include <algorithm>
+#include "transpose.hpp"
+#include "pipe_feeder.hpp"
 
 constexpr int Kbl1 = 1;
 class TransposeKernel;
+class FeederKernel;
 class IdPipeA;
+class PerfTimerKernel;
+class PerfId;
+
+// Horloge du kernel pour les compteurs (-DPERF_COUNTERS=1)
+constexpr double kFmaxMHz = 300.0;
 
 // Propriétés du pipe inchangées
 using pipe_props = decltype(
@@ -16,74 +23,17 @@ using pipe_props = decltype(
 
 using Complex   = ac_complex<float>;
 
+// Nombre d'échantillons par lecture du pipe : 8 × 64 bits = bus 512 bits
+constexpr int kLanes = 8;
+using Beat      = fpga_tools::WideBeat<Complex, kLanes>;
+
 using InputPipe = sycl::ext::intel::experimental::pipe<
-    IdPipeA, Complex, 0, pipe_props>;
-
-// Propriétés pour l'annotation de l'output
-using out_props = decltype(
-    sycl::ext::oneapi::experimental::properties{
-        sycl::ext::intel::experimental::buffer_location<Kbl1>,
-        sycl::ext::intel::experimental::dwidth<512>, //512
-        sycl::ext::intel::experimental::maxburst<8>, // 4
-        sycl::ext::intel::experimental::latency<0>,
-        sycl::ext::intel::experimental::read_write_mode_write,
-        // un Complex fait 2×32 bits = 64 bits = 8 octets d'alignement
-        sycl::ext::oneapi::experimental::alignment<64>}); //64
-
-using LSU512 = sycl::ext::intel::lsu<
-  sycl::ext::intel::burst_coalesce<true>,      // agrégation en bursts
-  sycl::ext::intel::statically_coalesce<true>>;// on garde l’analyse simple
-
-struct Transpose {
-  // out pointe maintenant sur un tableau de Complex
-  sycl::ext::oneapi::experimental::annotated_arg<
-  Complex*,
-      out_props>
-      out;
-  sycl::ext::oneapi::experimental::annotated_arg<
-      uint32_t,
-      decltype(sycl::ext::oneapi::experimental::properties{
-          sycl::ext::intel::experimental::conduit})>
-      rows; // ligne
-  sycl::ext::oneapi::experimental::annotated_arg<
-      uint32_t,
-      decltype(sycl::ext::oneapi::experimental::properties{
-          sycl::ext::intel::experimental::conduit})>
-      cols; // colonne
-
-    [[intel::kernel_args_restrict]]
-    void operator()() const {
-
-      // pragma unroll sur l'écriture doit avoir le même N que N réplication du buffer
-     [[intel::numbanks(2),intel::max_replicates(1)]] Complex buffer[2][2048][32];
-
-    [[intel::fpga_register]]   size_t ligne = rows ;
-    [[intel::fpga_register]] size_t colonne = cols ; // ça sera 2048 au max , ça changera pas
-
-    [[intel::fpga_register]] size_t nbCols = 32 ;   // Je veux faire les itérations 32 par 32 
-    [[intel::fpga_register]] size_t nbPass = ligne / nbCols;
-
-    [[intel::initiation_interval(1),intel::ivdep(buffer),intel::speculated_iterations(5)]]
-    for (size_t a = 0 ; a < nbPass ; a++ ){
-      [[intel::loop_coalesce(2),intel::initiation_interval(1)]] //
-      for (size_t i = 0 ; i < nbCols; i++){
-         for (size_t j = 0 ; j < colonne ; j++){
-             buffer[a%2][j][i] = InputPipe::read()  ;         // Transposé (2)    
-         }
-     }
-
-     [[intel::loop_coalesce(2)]]
-     for (size_t j = 0 ; j < colonne ; j++){
-        #pragma unroll
-         for (size_t i = 0 ; i < nbCols ; i++){
-             LSU512::store( sycl::address_space_cast<
-                            sycl::access::address_space::global_space,
-                            sycl::access::decorated::no>(out + j*ligne+i + (nbCols *a)), buffer[a%2][j][i]);
-         }
-      } 
-    }  
-  }  
-};
+    IdPipeA, Beat, 0, pipe_props>;
+
+// Bandes de 32 lignes, 2048 colonnes max, sortie 512 bits sur Kbl1
+using Transpose = fpga_tools::TransposeStream<InputPipe, Complex, 32, 2048, 512, Kbl1, kLanes,
+                                              fpga_tools::PerfSel<PerfId>>;
+using Feeder    = fpga_tools::PipeFeeder<InputPipe, Beat>;
 
 int main() {
   try {
@@ -100,30 +50,42 @@ int main() {
               << q.get_device().get_info<sycl::info::device::name>()
               << '\n';
 
-    const uint32_t rows     = 128;
-    const uint32_t cols     = 128;
+    const uint32_t rows     = 1000; // dernière bande partielle (1000 = 31 × 32 + 8)
+    const uint32_t cols     = 1024;
     const size_t   elements = size_t(rows) * cols;
+    if (!Transpose::accepte(rows, cols)) {
+      std::cerr << "cols doit être un multiple de " << kLanes << " et <= 2048\n";
+      return EXIT_FAILURE;
+    }
 
     // Allocation d'un tableau de Complex
     Complex* b = sycl::malloc_shared<Complex>(
       elements, q,
       {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl1)}) ;
 
-    // Génération et écriture dans le pipe
+    // Génération de la trame en mémoire hôte, kLanes échantillons par battement
+    const size_t nbBeats = elements / kLanes;
+    Beat* src = sycl::malloc_host<Beat>(nbBeats, q);
     for (uint32_t r = 0; r < rows; ++r) {
-      for (uint32_t c = 0; c < cols; ++c) {
-        // On simule un complexe (re, im = .5)
-        Complex a_vec(float(r * cols + c),
-                      float(r * cols + c) + 0.5f);
-         //std::cout << '(' << a_vec[0] << ',' << a_vec[1] << ") ";
-        InputPipe::write(q, a_vec);
+      for (uint32_t c = 0; c < cols; c += kLanes) {
+        Beat& beat = src[(size_t(r) * cols + c) / kLanes];
+        for (int l = 0; l < kLanes; ++l) {
+          // On simule un complexe (re, im = .5)
+          beat.v[l] = Complex(float(r * cols + c + l),
+                              float(r * cols + c + l) + 0.5f);
+        }
       }
-      //std::cout << '\n';
     }
 
     std::cout << "\nAprès transposition :\n";
 
-    // Lancement du kernel
+#if PERF_COUNTERS
+    auto* perf = sycl::malloc_shared<fpga_tools::PerfCounters>(1, q);
+    q.single_task<PerfTimerKernel>(fpga_tools::PerfTimer<PerfId>{perf});
+#endif
+
+    // Lancement du kernel d'alimentation et de la transposition en parallèle
+    q.single_task<FeederKernel>(Feeder{src, nbBeats});
     q.single_task<TransposeKernel>(Transpose{b, rows, cols});
     q.wait();
 
@@ -142,8 +104,16 @@ int main() {
       //std::cout << '\n';
     }
 
+#if PERF_COUNTERS
+    // Octets écrits en mémoire ; l'entrée arrive par le pipe
+    fpga_tools::printPerf(std::cout, "TransposeStream", *perf, elements,
+                          elements * sizeof(Complex), kFmaxMHz);
+    sycl::free(perf, q);
+#endif
+
     std::cout << (ok ? "PASSED\n" : "FAILED\n");
 
+    sycl::free(src, q);
     sycl::free(b, q);
     return ok ? EXIT_SUCCESS : EXIT_FAILURE;
   } catch (const sycl::exception& e) {
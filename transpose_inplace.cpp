@@ -0,0 +1,64 @@
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include "exception_handler.hpp"
+#include "transpose.hpp"
+
+constexpr int Kbl1 = 1;
+
+class TransposeInPlaceKernel;
+
+using Complex = ac_complex<float>;
+using Traits  = fpga_tools::ElemTraits<Complex>;
+
+// Tuiles 32 × 32, bus 512 bits, données dans Kbl1
+using TransposeIP = fpga_tools::TransposeInPlace<Complex, 32, 512, Kbl1>;
+
+int main() {
+  try {
+#if   FPGA_SIMULATOR
+    auto sel = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto sel = sycl::ext::intel::fpga_selector_v;
+#else
+    auto sel = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+    sycl::queue q(sel, fpga_tools::exception_handler);
+
+    std::cout << "Device : "
+              << q.get_device().get_info<sycl::info::device::name>()
+              << '\n';
+
+    const uint32_t n = 1000; // non multiple de 32 : tuiles de bord partielles
+    const size_t   elements = size_t(n) * n;
+
+    // Une seule allocation : entrée et sortie partagent le même buffer
+    Complex* m = sycl::malloc_shared<Complex>(
+      elements, q,
+      {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl1)}) ;
+
+    for (uint32_t r = 0; r < n; ++r)
+      for (uint32_t c = 0; c < n; ++c)
+        m[size_t(r) * n + c] = Traits::make(r * n + c);
+
+    std::cout << "Mémoire device : " << elements * sizeof(Complex) / (1 << 20)
+              << " Mio (au lieu de " << 2 * elements * sizeof(Complex) / (1 << 20)
+              << " Mio hors place)\n";
+
+    q.single_task<TransposeInPlaceKernel>(TransposeIP{m, n});
+    q.wait();
+
+    bool ok = true;
+    for (uint32_t r = 0; r < n; ++r)
+      for (uint32_t c = 0; c < n; ++c)
+        if (!Traits::same(m[size_t(r) * n + c], Traits::make(c * n + r)))
+          ok = false;
+
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
+
+    sycl::free(m, q);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const sycl::exception& e) {
+    std::cerr << "SYCL exception : " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
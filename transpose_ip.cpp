@@ -0,0 +1,103 @@
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include "exception_handler.hpp"
+#include "transpose.hpp"
+
+// IP pilotées par le Nios (nios_ddr.c / transpose_drv.c) : c'est ce source
+// que compilent les cibles cmake, et la cible csr_header relit la carte CSR
+// de ces deux kernels :
+//   TransposeCsrIP  -> préfixe TRANSPOSE       (une trame par start)
+//   TransposeRingIP -> préfixe TRANSPOSE_RING  (anneau de descripteurs)
+// Sur PC, le main vérifie les deux kernels comme le ferait le pilote.
+
+constexpr int KblRing = 0; // descripteurs (on-chip côté Nios)
+constexpr int Kbl1 = 1;
+constexpr int Kbl2 = 2;
+
+class TransposeCsrIP;
+class TransposeRingIP;
+
+using Elem   = int;                       // uint32_t côté Nios
+using Traits = fpga_tools::ElemTraits<Elem>;
+using Csr    = fpga_tools::TransposeCsr<Elem>;
+using Ring   = fpga_tools::TransposeRing<Elem, Traits::kTileRows, Traits::kTileCols,
+                                         Traits::kNumBuffers, 512, Kbl1, Kbl2, KblRing>;
+
+constexpr uint32_t kRingSize = 4;
+constexpr uint32_t kFrames = 3; // ring[3], ring[0], ring[1] : tour de l'anneau
+
+// Nombre d'éléments faux de la trame f (out = in transposée)
+uint32_t verifier(const Elem* out, uint32_t rows, uint32_t cols, uint32_t f) {
+  uint32_t erreurs = 0;
+  for (uint32_t r = 0; r < cols; ++r)
+    for (uint32_t c = 0; c < rows; ++c)
+      erreurs += !Traits::same(out[size_t(r) * rows + c],
+                               Traits::make(f * rows * cols + c * cols + r));
+  return erreurs;
+}
+
+int main() {
+  try {
+#if   FPGA_SIMULATOR
+    auto sel = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto sel = sycl::ext::intel::fpga_selector_v;
+#else
+    auto sel = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+    sycl::queue q(sel, fpga_tools::exception_handler);
+
+    std::cout << "Device : "
+              << q.get_device().get_info<sycl::info::device::name>()
+              << '\n';
+
+    const uint32_t rows = 48; // tuiles de bord dans les deux sens
+    const uint32_t cols = 40;
+    const size_t   elements = size_t(rows) * cols;
+
+    Elem* in = sycl::malloc_shared<Elem>(
+      elements * kFrames, q,
+      {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl1)});
+    Elem* out = sycl::malloc_shared<Elem>(
+      elements * kFrames, q,
+      {sycl::ext::intel::experimental::property::usm::buffer_location(Kbl2)});
+    fpga_tools::TransposeDesc* ring = sycl::malloc_shared<fpga_tools::TransposeDesc>(
+      kRingSize, q,
+      {sycl::ext::intel::experimental::property::usm::buffer_location(KblRing)});
+    for (size_t i = 0; i < elements * kFrames; ++i)
+      in[i] = Traits::make(uint32_t(i));
+
+    // 1) Une trame par start, arguments en registres CSR
+    q.single_task<TransposeCsrIP>(Csr{in, out, rows, cols}).wait();
+    uint32_t erreurs = verifier(out, rows, cols, 0);
+    std::cout << "CSR : " << erreurs << " erreurs\n";
+
+    // 2) Anneau : kFrames descripteurs à partir de ring[kRingSize - 1]
+    for (uint32_t d = 0; d < kRingSize; ++d)
+      ring[d] = fpga_tools::TransposeDesc{0, 0, 0, 0, 0, 0};
+    const uint32_t first = kRingSize - 1;
+    for (uint32_t f = 0; f < kFrames; ++f) {
+      const uint64_t off = uint64_t(f) * elements * sizeof(Elem);
+      ring[(first + f) % kRingSize] = fpga_tools::TransposeDesc{off, off, rows, cols, f + 1, 0};
+    }
+    q.single_task<TransposeRingIP>(Ring{in, out, ring, kRingSize, first, kFrames}).wait();
+
+    uint32_t erreursRing = 0;
+    for (uint32_t f = 0; f < kFrames; ++f) {
+      const fpga_tools::TransposeDesc& d = ring[(first + f) % kRingSize];
+      erreursRing += verifier(out + f * elements, rows, cols, f) + (d.status != d.seq);
+    }
+    std::cout << "Anneau : " << kFrames << " trames, " << erreursRing << " erreurs\n";
+
+    const bool ok = erreurs == 0 && erreursRing == 0;
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
+
+    sycl::free(in, q);
+    sycl::free(out, q);
+    sycl::free(ring, q);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const sycl::exception& e) {
+    std::cerr << "SYCL exception : " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
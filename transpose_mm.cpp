@@ -1,96 +1,57 @@
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
-#include <string>
-#include <queue>
+#include <vector>
 
-#define tTuile 4
+#include "transpose_cpu.hpp"
 
-static constexpr std::size_t ligne = 12;
-static constexpr std::size_t colonne = 8;
+// Validation et mesure du backend CPU (transpose_cpu.hpp) contre la double
+// boucle naïve, pour des éléments 32 bits et des complexes float.
+// Compiler avec -O3 -mavx2 (ou -mavx512f / -march=native) -pthread.
 
-void filTab(int (*t0)[colonne]){
-    for (size_t i = 0 ; i < ligne ; i++){
-        for (size_t j = 0 ; j < colonne ; j++){
-            t0[i][j] = i*colonne+j ;
-            std::cout <<  t0[i][j]  << ' ';
-        }
-        std::cout << "\n" ;
-    }
+template <typename T>
+void naive(const T* in, T* out, uint32_t ligne, uint32_t colonne) {
+    for (uint32_t i = 0; i < colonne; ++i)
+        for (uint32_t j = 0; j < ligne; ++j)
+            out[size_t(i) * ligne + j] = in[size_t(j) * colonne + i];
 }
 
-void viewTab(int (*t1)[ligne]){
-
-    for (std::size_t i = 0; i < colonne; ++i) {
-        for (std::size_t j = 0; j < ligne; ++j) {
-            std::cout << t1[i][j] << ' ';
-        }
-        std::cout << '\n';
-    }
-}
-
-void AfficheTuile(int (*buffer)[tTuile]){
-    for (u_int8_t i = 0 ; i < tTuile ; i++){
-        for (u_int8_t j = 0 ; j < tTuile ; j++){
-            std::cout << buffer[i][j] << ' ';         
-        }
-        std::cout << '\n';
-    }
-    std::cout << "\n" ;
-} 
-
-void transposetTuile(int (*t0)[colonne],int (*t1)[ligne]){
-
-    for (std::size_t i = 0; i < colonne; ++i) {
-        for (std::size_t j = 0; j < ligne; ++j) {
-            t1[i][j] = t0[j][i];
-            std::cout << t1[i][j] << ' ';
-             //std::cout << j*colonne+i << ' ';
-        }
-        std::cout << '\n';
-    }
+template <typename T>
+bool test(uint32_t ligne, uint32_t colonne, const char* nom) {
+    const size_t element = size_t(ligne) * colonne;
+    std::vector<T> t0(element), t1(element), ref(element);
+    for (size_t i = 0; i < element; ++i)
+        t0[i] = T(float(i));
+
+    auto d0 = std::chrono::steady_clock::now();
+    naive(t0.data(), ref.data(), ligne, colonne);
+    auto d1 = std::chrono::steady_clock::now();
+    fpga_tools::cpu::transpose(t0.data(), t1.data(), ligne, colonne);
+    auto d2 = std::chrono::steady_clock::now();
+
+    const double sNaif = std::chrono::duration<double>(d1 - d0).count();
+    const double sCpu = std::chrono::duration<double>(d2 - d1).count();
+    const bool ok = std::memcmp(t1.data(), ref.data(), element * sizeof(T)) == 0;
+
+    std::cout << nom << ' ' << ligne << 'x' << colonne << " : "
+              << (ok ? "PASSED" : "FAILED")
+              << "  naïf " << sNaif * 1e3 << " ms, backend " << sCpu * 1e3 << " ms ("
+              << 2.0 * element * sizeof(T) / sCpu / 1e9 << " Go/s)\n";
+    return ok;
 }
 
 int main () {
-  
-    int (*t0)[colonne] = new int[ligne][colonne];  // tableau d'entrée
-    int (*t1)[ligne] = new int [colonne][ligne]  ; // tableau de sortie
-    int (*buffer)[tTuile] = new int [tTuile][tTuile] ; // buffer
-
-    std::queue<int> myFifo ;
-
-    // remplie le tableau d'entrée
-    std::cout << "Matrice d'origine - ligne : " << ligne << " colonne : " << colonne << std::endl << "\n" ; 
-    filTab(t0);
+    bool ok = true;
 
-    size_t nbPassH = colonne / tTuile ;
-    size_t nbPassV = ligne / tTuile ;
+    // Tailles non multiples des micro-tuiles et des blocs
+    ok &= test<uint32_t>(12, 8, "uint32");
+    ok &= test<uint32_t>(1000, 1203, "uint32");
+    ok &= test<std::complex<float>>(12, 8, "complex<float>");
+    ok &= test<std::complex<float>>(3000, 1200, "complex<float>");
+    ok &= test<std::complex<float>>(4096, 4096, "complex<float>");
 
-    size_t totalPass = nbPassV * nbPassH;
-    for (size_t pass = 0; pass < totalPass; ++pass) {
-        size_t a = pass / nbPassH;  // ligne de tuiles
-        size_t b = pass % nbPassH;  // colonne de tuiles
-
-        // Extraction du bloc dans buffer
-        for (u_int8_t i = 0; i < tTuile; ++i) {
-            for (u_int8_t j = 0; j < tTuile; ++j) {
-                buffer[i][j] = t0[a * tTuile + i][b * tTuile + j];
-            }
-        }
-
-        std::cout << "\n Buffer " << (pass + 1) << "\n\n";
-        AfficheTuile(buffer);
-
-        // Écriture transposée dans t1
-        for (u_int8_t i = 0; i < tTuile; ++i) {
-            for (u_int8_t j = 0; j < tTuile; ++j) {
-                t1[b * tTuile + i][a * tTuile + j] = buffer[j][i];
-            }
-        }
-        viewTab(t1);
-    }
-
-
-    delete[] t0 ;
-    delete[] t1 ;
-    delete[] buffer ;
-    return 0 ;
-}
\ No newline at end of file
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include "exception_handler.hpp"
+#include "transpose.hpp"
+
+#include <vector>
+
+// Nombre d'instances et de banques EMIF ; bandes en Kbl1 .. Kbl1 + kNumBanks - 1
+constexpr int kNumCU = 4;
+constexpr int kNumBanks = 4;
+constexpr int Kbl1 = 1;
+
+using Complex = ac_complex<float>;
+using Traits  = fpga_tools::ElemTraits<Complex>;
+using MultiCU = fpga_tools::TransposeMultiCU<Complex, kNumCU, kNumBanks, Kbl1>;
+
+// Fréquence du kernel pour convertir le temps mesuré en cycles
+constexpr double kFmaxMHz = 300.0;
+
+int main() {
+  try {
+#if   FPGA_SIMULATOR
+    auto sel = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto sel = sycl::ext::intel::fpga_selector_v;
+#else
+    auto sel = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+    sycl::queue q(sel, fpga_tools::exception_handler,
+                  sycl::property::queue::enable_profiling{});
+
+    std::cout << "Device : "
+              << q.get_device().get_info<sycl::info::device::name>()
+              << '\n';
+
+    const uint32_t rows = 1000; // non multiple de 32 ni de kNumCU × 32
+    const uint32_t cols = 1200;
+    const size_t   elements = size_t(rows) * cols;
+
+    // Bandes allouées chacune dans sa banque, remplies sur place
+    MultiCU cu;
+    cu.alloc(q, rows, cols);
+    for (uint32_t r = 0; r < rows; ++r)
+      for (uint32_t c = 0; c < cols; ++c)
+        cu.in(r, c) = Traits::make(r * cols + c);
+
+    for (int k = 0; k < kNumCU; ++k)
+      std::cout << "CU " << k << " : lignes " << cu.bandes[k].r0 << " .. "
+                << cu.bandes[k].r0 + cu.bandes[k].h << ", banques "
+                << MultiCU::inBank(k) << " -> " << MultiCU::outBank(k) << '\n';
+
+    // Lancement des kNumCU kernels, un seul wait
+    std::vector<sycl::event> ev = cu.launch(q);
+    q.wait();
+
+    // Durée globale : du premier départ à la dernière fin
+    uint64_t debut = UINT64_MAX, fin = 0;
+    for (auto& e : ev) {
+      debut = std::min(debut, e.get_profiling_info<sycl::info::event_profiling::command_start>());
+      fin = std::max(fin, e.get_profiling_info<sycl::info::event_profiling::command_end>());
+    }
+    const double ns = double(fin - debut);
+
+    bool ok = true;
+    for (uint32_t r = 0; r < cols; ++r)
+      for (uint32_t c = 0; c < rows; ++c)
+        if (!Traits::same(cu.out(r, c), Traits::make(c * cols + r)))
+          ok = false;
+
+    std::cout << ns / 1000.0 << " us, "
+              << ns * kFmaxMHz / 1000.0 / elements << " cycles/élément, "
+              << 2.0 * elements * sizeof(Complex) / ns << " Go/s (lecture + écriture)\n";
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
+
+    cu.free(q);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const sycl::exception& e) {
+    std::cerr << "SYCL exception : " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}
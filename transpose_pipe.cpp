@@ -0,0 +1,164 @@
+#include <sycl/ext/intel/fpga_extensions.hpp>
+#include <sycl/sycl.hpp>
+#include "exception_handler.hpp"
+#include <sycl/ext/intel/ac_types/ac_complex.hpp>
+
+#include <algorithm>
+
+#include "transpose.hpp"
+#include "pipe_feeder.hpp"
+
+class TransposeKernel;
+class FeederKernel;
+class SinkKernel;
+class IdPipeA;
+class IdPipeB;
+class FrameKernel;
+class FeederFrameKernel;
+class SinkFrameKernel;
+class IdPipeC;
+class IdPipeD;
+
+constexpr int kStripeRows = 32;
+
+// Propriétés du pipe inchangées
+using pipe_props = decltype(
+    sycl::ext::oneapi::experimental::properties(
+        sycl::ext::intel::experimental::ready_latency<0>));
+
+using Complex   = ac_complex<float>;
+using Beat      = fpga_tools::StreamBeat<Complex>;
+
+using InputPipe = sycl::ext::intel::experimental::pipe<
+    IdPipeA, Complex, 0, pipe_props>;
+
+// Pipe interne entre la transposition et le kernel aval
+using OutputPipe = sycl::ext::intel::experimental::pipe<
+    IdPipeB, Beat, 64, pipe_props>;
+
+using Transpose = fpga_tools::TransposePipe<InputPipe, OutputPipe, Complex, kStripeRows, 2048>;
+using Feeder    = fpga_tools::PipeFeeder<InputPipe, Complex>;
+
+// Chaîne de la vraie transposée : trames entières de 48 × 40 au plus 64 × 64
+using InputPipeF  = sycl::ext::intel::experimental::pipe<IdPipeC, Complex, 0, pipe_props>;
+using OutputPipeF = sycl::ext::intel::experimental::pipe<IdPipeD, Beat, 64, pipe_props>;
+using TransposeF  = fpga_tools::TransposePipeFrame<InputPipeF, OutputPipeF, Complex, 64, 64>;
+using FeederF     = fpga_tools::PipeFeeder<InputPipeF, Complex>;
+
+// Kernel aval de test : recopie le flux tel quel en mémoire et compte les
+// erreurs de sideband (sof ailleurs qu'au début, eof ailleurs qu'à la fin
+// de chaque trame de n éléments)
+template <typename Pipe>
+struct Sink {
+  Complex* flux;
+  uint32_t* erreurs;
+  uint32_t n;
+  uint32_t frames{1};
+
+  void operator()() const {
+    uint32_t err = 0;
+    for (uint32_t f = 0; f < frames; f++) {
+      for (uint32_t t = 0; t < n; t++) {
+        Beat v = Pipe::read();
+        flux[size_t(f) * n + t] = v.data;
+        if (v.sof != (t == 0) || v.eof != (t == n - 1))
+          err++;
+      }
+    }
+    *erreurs = err;
+  }
+};
+
+int main() {
+  try {
+#if   FPGA_SIMULATOR
+    auto sel = sycl::ext::intel::fpga_simulator_selector_v;
+#elif FPGA_HARDWARE
+    auto sel = sycl::ext::intel::fpga_selector_v;
+#else
+    auto sel = sycl::ext::intel::fpga_emulator_selector_v;
+#endif
+    sycl::queue q(sel, fpga_tools::exception_handler);
+
+    std::cout << "Device : "
+              << q.get_device().get_info<sycl::info::device::name>()
+              << '\n';
+
+    const uint32_t rows     = 80;  // dernière bande partielle (80 = 2 × 32 + 16)
+    const uint32_t cols     = 128;
+    const size_t   elements = size_t(rows) * cols;
+
+    Complex* flux = sycl::malloc_shared<Complex>(elements, q);
+    uint32_t* erreurs = sycl::malloc_shared<uint32_t>(1, q);
+
+    // Génération de la trame en mémoire hôte
+    Complex* src = sycl::malloc_host<Complex>(elements, q);
+    for (uint32_t r = 0; r < rows; ++r) {
+      for (uint32_t c = 0; c < cols; ++c) {
+        src[size_t(r) * cols + c] = Complex(float(r * cols + c),
+                                            float(r * cols + c) + 0.5f);
+      }
+    }
+
+    // Lancement des trois kernels chaînés
+    q.single_task<FeederKernel>(Feeder{src, elements});
+    q.single_task<TransposeKernel>(Transpose{rows, cols});
+    q.single_task<SinkKernel>(Sink<OutputPipe>{flux, erreurs, uint32_t(elements)});
+    q.wait();
+
+    // Vérification de l'ordre d'émission : bande a, ligne de sortie j,
+    // élément i de la bande  ->  in[a * 32 + i][j]
+    bool ok = (*erreurs == 0);
+    size_t t = 0;
+    for (uint32_t a = 0; a * kStripeRows < rows; ++a) {
+      const uint32_t h = std::min<uint32_t>(kStripeRows, rows - a * kStripeRows);
+      for (uint32_t j = 0; j < cols; ++j) {
+        for (uint32_t i = 0; i < h; ++i, ++t) {
+          const uint32_t src = (a * kStripeRows + i) * cols + j;
+          if (flux[t].r() != float(src) || flux[t].i() != float(src) + 0.5f)
+            ok = false;
+        }
+      }
+    }
+
+    std::cout << "Erreurs sideband : " << *erreurs << '\n';
+
+    // Vraie transposée : 2 trames 48 × 40, out[j][i] = in[i][j] ligne à ligne
+    const uint32_t rowsF = 48, colsF = 40, framesF = 2;
+    const size_t elemF = size_t(rowsF) * colsF;
+    Complex* srcF  = sycl::malloc_host<Complex>(elemF * framesF, q);
+    Complex* fluxF = sycl::malloc_shared<Complex>(elemF * framesF, q);
+    for (size_t k = 0; k < elemF * framesF; ++k)
+      srcF[k] = Complex(float(k), float(k) + 0.5f);
+
+    q.single_task<FeederFrameKernel>(FeederF{srcF, elemF * framesF});
+    q.single_task<FrameKernel>(TransposeF{rowsF, colsF, framesF});
+    q.single_task<SinkFrameKernel>(Sink<OutputPipeF>{fluxF, erreurs, uint32_t(elemF), framesF});
+    q.wait();
+
+    bool okF = (*erreurs == 0);
+    for (uint32_t f = 0; f < framesF; ++f)
+      for (uint32_t j = 0; j < colsF; ++j)
+        for (uint32_t i = 0; i < rowsF; ++i) {
+          const size_t src = f * elemF + size_t(i) * colsF + j;
+          const Complex v = fluxF[f * elemF + size_t(j) * rowsF + i];
+          if (v.r() != float(src) || v.i() != float(src) + 0.5f)
+            okF = false;
+        }
+    std::cout << "Trame entière : " << (okF ? "PASSED" : "FAILED")
+              << ", erreurs sideband " << *erreurs << '\n';
+    ok &= okF;
+
+    std::cout << (ok ? "PASSED\n" : "FAILED\n");
+
+    sycl::free(srcF, q);
+    sycl::free(fluxF, q);
+    sycl::free(src, q);
+    sycl::free(flux, q);
+    sycl::free(erreurs, q);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const sycl::exception& e) {
+    std::cerr << "SYCL exception : " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+}